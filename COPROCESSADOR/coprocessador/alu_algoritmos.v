@@ -8,6 +8,15 @@ module alu_algoritmos ( // Sugestão: adicione '_hps' para clareza
     // tipo_alg -> [6:3],    // 0000  
 
     input wire        start_in,        // Recebe o pulso de início do HPS
+
+    // Passos do escalonador DDA (tipo_alg 0110), em ponto fixo 16.16:
+    // pixels da imagem fonte por pixel da tela (0x10000 = 1x, 0x8000 = 2x)
+    input wire [31:0] passo_x_in,
+    input wire [31:0] passo_y_in,
+
+    // Região de interesse da imagem fonte (pio_roi):
+    // {ativa[31], alt[30:24], larg[23:16], y0[14:8], x0[7:0]}
+    input wire [31:0] roi_in,
 	 
     // Interface com a RAM  160x120 (síncrona)
     input wire [7:0] rom_data_in,
@@ -18,7 +27,14 @@ module alu_algoritmos ( // Sugestão: adicione '_hps' para clareza
     output reg [18:0] ram_addr_out,
     output reg ram_wren_out,
 	 
-    output wire [31:0] status_data_out // Envia o status para o HPS
+    output wire [31:0] status_data_out, // Envia o status para o HPS
+    output wire [31:0] limpeza_data_out, // Ciclos da fase de limpeza
+    output wire        rom_leitura_out,  // Dado da ROM consumido neste ciclo
+
+    // Área ativa da última operação, para o estágio de saída do VGA:
+    // {y[19:10], x[9:0]} do canto inicial e do canto final (exclusivo)
+    output wire [19:0] area_ini_out,
+    output wire [19:0] area_fim_out
 );
 
 	 wire [2:0] zoom_enable;
@@ -32,12 +48,29 @@ module alu_algoritmos ( // Sugestão: adicione '_hps' para clareza
 
 	 reg done;
 	 
+	 // Contador de ciclos da operação atual: zera no reset (start), conta
+	 // enquanto done=0 e congela quando a FSM chega ao estado final
+	 reg [29:0] cycle_count;
+	 
+	 // status_data_out = {cycle_count[29:0], ocupado, concluido}
+	 // Lido pelo HPS no pio_status (0x18020)
+	 assign status_data_out = {cycle_count, ~done, done};
+	 
+	 // Parte de cycle_count gasta fora da área ativa. Nenhum opcode limpa
+	 // mais o framebuffer (o VGA pinta de preto o que está fora da área),
+	 // então sobram só os saltos de borda das varreduras S_PROCESS_PIXEL.
+	 // Lido pelo HPS no pio_limpeza (0x18070)
+	 reg [29:0] clear_count;
+	 assign limpeza_data_out = {2'b00, clear_count};
+	 
 	/*
      0000 -> sem nada
      0001 -> media
-     0010 -> vizinho in 2x
+     0010 -> vizinho in (1x, 2x, 4x)
      0011 -> vizinho out 0.5x
-     0100 -> replicaçao
+     0100 -> replicaçao (mesmo pipeline do vizinho in)
+     0101 -> bilinear (1x, 2x, 4x)
+     0110 -> escala DDA (fator qualquer, passos em passo_x_in/passo_y_in)
 	*/
 
     // Parâmetros da imagem original
@@ -49,53 +82,32 @@ module alu_algoritmos ( // Sugestão: adicione '_hps' para clareza
     localparam RAM_HEIGHT = 480;
     localparam RAM_SIZE = RAM_WIDTH * RAM_HEIGHT;
      
-    // parametros usados no vizinho mais proximo 
     localparam ROM_SIZE = ROM_IMG_W * ROM_IMG_H;
-    localparam NO_ZOOM_OFFSET_X = 240; // (640 - 160)/2
-    localparam NO_ZOOM_OFFSET_Y = 180; // (480 - 120)/2
-    localparam ZOOM_OFFSET_X = 160; // (640 - 320)/2
-    localparam ZOOM_OFFSET_Y = 120; // (480 - 240)/2
-    localparam ZOOM4X_OFFSET_Y = 0;
-    localparam ZOOM4X_OFFSET_X = 0;
-	  
-	 localparam ZOOM_OUT_025_OFFSET_X = 300; // (640-40)/2
-    localparam ZOOM_OUT_025_OFFSET_Y = 225; // (480-30)/2
-
-    // Offsets para centralizar as imagens
-    localparam NORMAL_OFFSET_X = 240;   // (640-160)/2
-    localparam NORMAL_OFFSET_Y = 180;   // (480-120)/2
-    localparam ZOOM_OUT_OFFSET_X = 280; // (640-80)/2
-    localparam ZOOM_OUT_OFFSET_Y = 210; // (480-60)/2
-    localparam ZOOM_IN_OFFSET_X = 160;   // (640-320)/2
-    localparam ZOOM_IN_OFFSET_Y = 120;   // (480-240)/2
-    
-    // Estados da FSM MEDIA DE BLOCOS 
+
+    // Sem offsets fixos: a área de cada opcode é centralizada a partir do
+    // tamanho da fonte (imagem inteira ou ROI), veja calc_x1/calc_y1
+
+    // Estados comuns (bypass)
     localparam S_IDLE              = 4'd0;
-    localparam S_CLEAR_FRAME       = 4'd1;
     localparam S_PROCESS_PIXEL     = 4'd2;
-    localparam S_FETCH_PIXEL_READ  = 4'd3; // Estado único para ler pixel no modo normal
     localparam S_WRITE_RAM         = 4'd4;
     localparam S_DONE              = 4'd5;
-	 
-
-	localparam S_FETCH_16_INIT     = 4'd11;
-	localparam S_FETCH_16_SET_ADDR = 4'd12;
-	localparam S_FETCH_16_READ_ADD = 4'd13;
-	localparam S_WRITE_RAM_AVG     = 4'd14;
-	localparam S_CALC_AVERAGE_4    = 4'd15;
-
-
-    // Estados pipelined para ler o bloco 2x2 no zoom out
-    localparam S_FETCH_BLOCK_00    = 4'd6;
-    localparam S_FETCH_BLOCK_01    = 4'd7;
-    localparam S_FETCH_BLOCK_10    = 4'd8;
-    localparam S_FETCH_BLOCK_11    = 4'd9;
-    localparam S_CALC_AVERAGE      = 4'd10;
-	 localparam S_CLEAR_ALL = 4'd11;
 
-    // Estados FSM VIZINHO
-    localparam S_CLEAR_BORDERS   = 3'd1;
-    localparam S_SET_ADDR        = 3'd2;
+    // Estados FSM MEDIA DE BLOCOS (linha de acumuladores)
+    localparam S_MD_STREAM         = 4'd1;
+    localparam S_MD_DRAIN          = 4'd3;
+
+    // Estados FSM BILINEAR
+    localparam S_BL_CARGA        = 4'd1;
+    localparam S_BL_Q0           = 4'd2;
+    localparam S_BL_STREAM       = 4'd3;
+    localparam S_BL_DRAIN        = 4'd4;
+
+    // Estados FSM VIZINHO (pipeline de 1 pixel por ciclo)
+    localparam S_NN_STREAM       = 4'd1;
+    localparam S_NN_DRAIN        = 4'd2;
+    localparam S_ESC_MEDIDA      = 4'd3;
+    localparam S_ESC_INICIO      = 4'd4;
     localparam S_READ_ROM        = 3'd3;
      
     // Estados FSM vizinho 0.5x
@@ -103,7 +115,6 @@ module alu_algoritmos ( // Sugestão: adicione '_hps' para clareza
      
     // Estados FSM VIZINHO 0.5x
     localparam VZ05_IDLE = 4'd0;
-    localparam VZ05_CLEAR_FRAME = 4'd1;
     localparam VZ05_PROCESS_PIXEL = 4'd2;
     localparam VZ05_SET_ROM_ADDR = 4'd3;
     localparam VZ05_READ_ROM = 4'd4;
@@ -125,21 +136,53 @@ module alu_algoritmos ( // Sugestão: adicione '_hps' para clareza
      
      
     
-    // Registradores para media de blocos 4x4
-	reg [11:0] sum_pixels;        // 12-bit accumulator
-	reg [1:0] block_x_counter;    // Counter for 4x4 block columns
-	reg [1:0] block_y_counter;    // Counter for 4x4 block rows
+    // Registradores para media de blocos
+    reg [7:0]  md_x;              // estágio 0: pixel da imagem fonte
+    reg [6:0]  md_y;
+    reg [14:0] md_addr;
+    reg [7:0]  md_x1;             // estágio 1: mesmo pixel, com rom_data_in
+    reg [6:0]  md_y1;
+    reg        md_valid1;
+    reg [9:0]  md_soma_h;         // soma do bloco na linha atual (até 4 pixels)
+    reg [11:0] md_linha [0:ROM_IMG_W/2-1]; // soma das linhas anteriores, por coluna de saída
 		  
 		  
     reg [3:0] state;
     reg [18:0] ram_counter;
+
+    // regs bilinear (cache de duas linhas)
+    reg [7:0] bl_linha0 [0:ROM_IMG_W-1]; // linhas da imagem fonte: uma é a
+    reg [7:0] bl_linha1 [0:ROM_IMG_W-1]; // superior, a outra recebe a inferior
+    reg       bl_banco;          // banco com a linha superior (estágio 0)
+    reg [7:0] bl_cx;             // coluna da carga inicial
+    reg [9:0] bl_x;              // estágio 0: pixel da área ativa
+    reg [8:0] bl_y;
+    reg [7:0] bl_q0;             // pixel inferior esquerdo do bloco atual
+    reg [7:0] bl_x0_1, bl_x1_1;  // estágio 1
+    reg [1:0] bl_fx4_1, bl_fy4_1;
+    reg       bl_ultima_1, bl_borda_1, bl_banco_1, bl_valid1;
+    reg [18:0] bl_dest1;
+    reg [9:0] bl_h_sup, bl_h_inf; // estágio 2: interpolação horizontal
+    reg [1:0] bl_fy4_2;
+    reg       bl_valid2;
+    reg [18:0] bl_dest2;
      
-    // regs vizinho prox 2x
-    reg [14:0] pixel_counter;
-    reg [3:0] zoom_phase;
-    reg [7:0] rom_x;
-    reg [6:0] rom_y;
+    // regs vizinho prox (pipeline)
+    reg [9:0] nn_x;              // estágio 0: pixel da tela
+    reg [8:0] nn_y;
+    reg [7:0] nn_sx;             // estágio 1: pixel da imagem fonte
+    reg [6:0] nn_sy;
+    reg [18:0] nn_dest1, nn_dest2;
+    reg nn_valid1, nn_valid2;
     reg [7:0] rom_data_reg;
+
+    // regs escala DDA (mesmo pipeline do vizinho prox)
+    reg [31:0] esc_passo_x, esc_passo_y; // capturados no start
+    reg [32:0] esc_acc_x, esc_acc_y;     // medida da área: n * passo
+    reg [9:0]  esc_larg;
+    reg [8:0]  esc_alt;
+    reg [23:0] esc_x;                    // estágio 0: coordenada 16.16 na fonte
+    reg [22:0] esc_y;
      
     // REGs vizinho mais prox 0.5x
     reg [7:0] src_x;
@@ -160,8 +203,6 @@ module alu_algoritmos ( // Sugestão: adicione '_hps' para clareza
     reg [6:0] rep_rom_y;
     reg [1:0] rep_phase;
 
-    // Registradores para armazenar os 4 pixels do bloco 2x2
-    reg [7:0] pixel_00, pixel_01, pixel_10, pixel_11;
      
     // Calcula coordenadas atuais da RAM
     always @(*) begin
@@ -169,21 +210,221 @@ module alu_algoritmos ( // Sugestão: adicione '_hps' para clareza
         current_y = ram_counter / RAM_WIDTH;
     end
      
+    // --- Região de interesse ---
+    // Com a ROI ativa a ALU lê só essa janela da imagem fonte, como se
+    // fosse a imagem inteira, e centraliza o resultado: zoom de uma seleção
+    // sem recarregar a imagem. Inativa, vazia ou fora da imagem: 160x120.
+    // Capturada durante o pulso de start, como os passos da escala
+    reg [31:0] roi;
+    always @(posedge clk) begin
+        if (reset)
+            roi <= roi_in;
+    end
+
+    wire [7:0]  roi_x0    = roi[7:0];
+    wire [6:0]  roi_y0    = roi[14:8];
+    wire [7:0]  roi_larg  = roi[23:16];
+    wire [6:0]  roi_alt   = roi[30:24];
+    wire        roi_valida = roi[31] && roi_larg != 0 && roi_alt != 0 &&
+                             roi_x0 + roi_larg <= ROM_IMG_W &&
+                             roi_y0 + roi_alt <= ROM_IMG_H;
+
+    wire [7:0]  fonte_x0   = roi_valida ? roi_x0   : 8'd0;
+    wire [6:0]  fonte_y0   = roi_valida ? roi_y0   : 7'd0;
+    wire [7:0]  fonte_larg = roi_valida ? roi_larg : ROM_IMG_W;
+    wire [6:0]  fonte_alt  = roi_valida ? roi_alt  : ROM_IMG_H;
+    wire [14:0] fonte_base = {fonte_y0, 7'b0} + {fonte_y0, 5'b0} + fonte_x0; // (x0, y0)
+
+    // --- Área ativa ---
+    // Retângulo da tela que o opcode escreve. Nenhuma FSM limpa o
+    // framebuffer: o estágio de saída do VGA (overlay_vga) pinta de preto
+    // tudo fora deste retângulo, então pixels velhos fora dele não aparecem.
+    reg [9:0] calc_x1, calc_larg;
+    reg [8:0] calc_y1, calc_alt;
+    reg [1:0] zoom_shift;        // log2 do fator de ampliação ou redução
+    reg       tipo_conhecido;    // área definida pelo opcode já no start
+
     always @(*) begin
-        rom_x = pixel_counter % ROM_IMG_W;
-        rom_y = pixel_counter / ROM_IMG_W;
+        // 1x
+        calc_larg = fonte_larg;     calc_alt = fonte_alt;
+        zoom_shift = 2'd0;
+        tipo_conhecido = 1'b1;
+
+        case (tipo_alg)
+            4'b0010, 4'b0100, 4'b0101: begin // vizinho in / replicação / bilinear
+                if (zoom_enable == 3'b010) begin // 4x
+                    calc_larg = fonte_larg << 2;  calc_alt = fonte_alt << 2;
+                    zoom_shift = 2'd2;
+                end else if (zoom_enable == 3'b001) begin // 2x
+                    calc_larg = fonte_larg << 1;  calc_alt = fonte_alt << 1;
+                    zoom_shift = 2'd1;
+                end
+            end
+            4'b0001, 4'b0011: begin // média / vizinho out
+                if (zoom_enable == 3'b011) begin // 0.5x
+                    calc_larg = fonte_larg >> 1;  calc_alt = fonte_alt >> 1;
+                    zoom_shift = 2'd1;
+                end else if (zoom_enable == 3'b100) begin // 0.25x
+                    calc_larg = fonte_larg >> 2;  calc_alt = fonte_alt >> 2;
+                    zoom_shift = 2'd2;
+                end
+            end
+            4'b0000, 4'b1111: ; // bypass: 1x
+            4'b0110: tipo_conhecido = 1'b0; // escala: área medida em S_ESC_MEDIDA
+            default: tipo_conhecido = 1'b0;
+        endcase
+
+        // Centralizada na tela
+        calc_x1 = (RAM_WIDTH - calc_larg) >> 1;
+        calc_y1 = (RAM_HEIGHT - calc_alt) >> 1;
+    end
+
+    // --- Escala DDA: medida da área ---
+    // A tela tem ceil(larg / passo_x) x ceil(alt / passo_y) pixels da fonte,
+    // limitados a 640x480: conta quantos n têm n * passo dentro da imagem,
+    // as duas direções em paralelo, sem divisor
+    always @(posedge clk) begin
+        if (reset) begin
+            esc_passo_x <= passo_x_in;
+            esc_passo_y <= passo_y_in;
+        end
+    end
+
+    wire esc_cont_x = esc_acc_x < {fonte_larg, 16'b0} && esc_larg != RAM_WIDTH;
+    wire esc_cont_y = esc_acc_y < {fonte_alt, 16'b0} && esc_alt != RAM_HEIGHT;
+    wire esc_medida_pronta = tipo_alg == 4'b0110 && state == S_ESC_MEDIDA &&
+                             !esc_cont_x && !esc_cont_y;
+    wire [9:0] esc_x1 = (RAM_WIDTH - esc_larg) >> 1;
+    wire [8:0] esc_y1 = (RAM_HEIGHT - esc_alt) >> 1;
+
+    // Capturada durante o pulso de start, como o banco da ROM em ghrd_top;
+    // a escala captura a área medida ao fim de S_ESC_MEDIDA.
+    // Opcodes sem FSM não tocam o framebuffer e mantêm a área anterior.
+    reg [9:0] area_x1 = 10'd0, area_x2 = RAM_WIDTH;
+    reg [8:0] area_y1 = 9'd0,  area_y2 = RAM_HEIGHT;
+
+    always @(posedge clk) begin
+        if (reset && tipo_conhecido) begin
+            area_x1 <= calc_x1;
+            area_y1 <= calc_y1;
+            area_x2 <= calc_x1 + calc_larg;
+            area_y2 <= calc_y1 + calc_alt;
+        end else if (esc_medida_pronta) begin
+            area_x1 <= esc_x1;
+            area_y1 <= esc_y1;
+            area_x2 <= esc_x1 + esc_larg;
+            area_y2 <= esc_y1 + esc_alt;
+        end
+    end
+
+    assign area_ini_out = {1'b0, area_y1, area_x1};
+    assign area_fim_out = {1'b0, area_y2, area_x2};
+
+    // Salto de endereço do fim de uma linha da área para o início da próxima
+    wire [9:0] area_salto = RAM_WIDTH - (area_x2 - area_x1) + 1;
+
+    // Próximo endereço dentro da área a partir de um pixel fora dela: as
+    // varreduras pulam as bordas em um ciclo em vez de percorrê-las.
+    // RAM_SIZE quando não restam linhas (fim da varredura)
+    reg [18:0] prox_area;
+    always @(*) begin
+        if (current_y < area_y1)
+            prox_area = area_y1 * RAM_WIDTH + area_x1;
+        else if (current_y >= area_y2)
+            prox_area = RAM_SIZE;
+        else if (current_x < area_x1)
+            prox_area = current_y * RAM_WIDTH + area_x1;
+        else if (current_y + 9'd1 < area_y2)
+            prox_area = (current_y + 9'd1) * RAM_WIDTH + area_x1;
+        else
+            prox_area = RAM_SIZE;
     end
-     
-     reg [1:0] local_offset_x;
-     reg [1:0] local_offset_y;
-     
-     always @(*) begin
-    local_offset_x = zoom_phase[1:0];
-    local_offset_y = zoom_phase[3:2];
-end    
     
         
     
+    // Contagem de ciclos (satura para nunca voltar a zero)
+    always @(posedge clk or posedge reset) begin
+        if (reset)
+            cycle_count <= 30'd0;
+        else if (!done && cycle_count != 30'h3FFFFFFF)
+            cycle_count <= cycle_count + 30'd1;
+    end
+
+    // Bits da coordenada que indicam a posição dentro do bloco do zoom
+    wire [1:0]  zoom_mascara = (zoom_shift == 2'd2) ? 2'd3 :  // bloco 4x4
+                               (zoom_shift == 2'd1) ? 2'd1 :  // bloco 2x2
+                                                      2'd0;   // 1x
+
+    // --- Média de blocos: posição do pixel no bloco e somas do estágio 1 ---
+    wire        md_ini_x   = (md_x1[1:0] & zoom_mascara) == 2'd0;
+    wire        md_fim_x   = (md_x1[1:0] & zoom_mascara) == zoom_mascara;
+    wire        md_ini_y   = (md_y1[1:0] & zoom_mascara) == 2'd0;
+    wire        md_fim_y   = (md_y1[1:0] & zoom_mascara) == zoom_mascara;
+    wire [6:0]  md_col     = md_x1 >> zoom_shift;
+    wire [9:0]  md_soma_h_atual = (md_ini_x ? 10'd0 : md_soma_h) + rom_data_in;
+    wire [11:0] md_soma_bloco   = (md_ini_y ? 12'd0 : md_linha[md_col]) + md_soma_h_atual;
+    wire [3:0]  md_arred   = (zoom_shift == 2'd2) ? 4'd8 :  // metade de 16
+                             (zoom_shift == 2'd1) ? 4'd2 :  // metade de 4
+                                                    4'd0;
+
+    // --- Bilinear: vizinhos e pesos do pixel no estágio 0 ---
+    // Pixel (x, y) da área cai entre as colunas x0..x1 e as linhas y0..y1
+    // da fonte, com pesos em quartos: fx4/4 à direita e fy4/4 embaixo.
+    // Na última coluna e na última linha o vizinho repete a borda.
+    wire [7:0]  bl_x0     = bl_x >> zoom_shift;
+    wire [6:0]  bl_y0     = bl_y >> zoom_shift;
+    wire        bl_borda  = (bl_x0 == fonte_larg - 1);
+    wire [7:0]  bl_x1     = bl_borda ? bl_x0 : bl_x0 + 8'd1;
+    wire [6:0]  bl_y1     = (bl_y0 == fonte_alt - 1) ? bl_y0 : bl_y0 + 7'd1;
+    wire [1:0]  bl_fx     = bl_x[1:0] & zoom_mascara;
+    wire [1:0]  bl_fy     = bl_y[1:0] & zoom_mascara;
+    wire [1:0]  bl_fx4    = (zoom_shift == 2'd1) ? {bl_fx[0], 1'b0} : bl_fx;
+    wire [1:0]  bl_fy4    = (zoom_shift == 2'd1) ? {bl_fy[0], 1'b0} : bl_fy;
+
+    // Linha inferior da próxima linha da área (lida no último bloco da linha)
+    wire [6:0]  bl_y0_prox = (bl_y + 9'd1) >> zoom_shift;
+    wire [6:0]  bl_y1_prox = (bl_y0_prox >= fonte_alt - 1) ? fonte_alt - 1 : bl_y0_prox + 7'd1;
+
+    // A ROM só fornece a linha inferior: o pixel (x1, y1) do bloco, ou o
+    // primeiro pixel inferior da próxima linha quando x1 repete a borda
+    wire [6:0]  bl_lin_rom  = fonte_y0 + (bl_borda ? bl_y1_prox : bl_y1);
+    wire [7:0]  bl_col_rom  = fonte_x0 + (bl_borda ? 8'd0 : bl_x1);
+    wire [14:0] bl_rom_addr = {bl_lin_rom, 7'b0} + {bl_lin_rom, 5'b0} + bl_col_rom;
+
+    wire [9:0]  area_larg = area_x2 - area_x1;
+    wire [8:0]  area_alt  = area_y2 - area_y1;
+
+    // --- Bilinear: estágio 1 ---
+    wire [7:0]  bl_sup_esq = bl_banco_1 ? bl_linha1[bl_x0_1] : bl_linha0[bl_x0_1];
+    wire [7:0]  bl_sup_dir = bl_banco_1 ? bl_linha1[bl_x1_1] : bl_linha0[bl_x1_1];
+    wire [7:0]  bl_inf_esq = bl_q0;
+    wire [7:0]  bl_inf_dir = bl_borda_1 ? bl_q0 : rom_data_in;
+
+    // Ciclos em que a FSM consome rom_data_in, para o contador de leituras
+    // de contadores_alu: um por pixel da área, mais a carga da primeira
+    // linha no bilinear e cada pixel da janela fonte na média
+    assign rom_leitura_out =
+        (tipo_alg == 4'b0000 || tipo_alg == 4'b1111) ? state == S_WRITE_RAM :
+        (tipo_alg == 4'b0011) ? state == VZ05_READ_ROM :
+        (tipo_alg == 4'b0001) ? md_valid1 :
+        (tipo_alg == 4'b0101) ? (state == S_BL_CARGA || state == S_BL_Q0 || bl_valid1) :
+        (tipo_alg == 4'b0010 || tipo_alg == 4'b0100 ||
+         tipo_alg == 4'b0110) ? nn_valid2 :
+                                1'b0;
+
+    wire fora_area  = current_x < area_x1 || current_x >= area_x2 ||
+                      current_y < area_y1 || current_y >= area_y2;
+    wire em_limpeza = (tipo_alg == 4'b0000 || tipo_alg == 4'b0011 ||
+                       tipo_alg == 4'b1111) &&
+                      state == S_PROCESS_PIXEL && ram_counter < RAM_SIZE && fora_area;
+
+    always @(posedge clk or posedge reset) begin
+        if (reset)
+            clear_count <= 30'd0;
+        else if (!done && em_limpeza && clear_count != 30'h3FFFFFFF)
+            clear_count <= clear_count + 30'd1;
+    end
+    
     // FSM Principal
     always @(posedge clk or posedge reset) begin
         if (reset) begin
@@ -192,6 +433,11 @@ end
             done <= 1'b0;
             ram_wren_out <= 1'b0;
             rom_addr_out <= 0;
+            nn_valid1 <= 1'b0;
+            nn_valid2 <= 1'b0;
+            md_valid1 <= 1'b0;
+            bl_valid1 <= 1'b0;
+            bl_valid2 <= 1'b0;
             // Zera outros registradores se necessário
         end else begin
             case(tipo_alg) 
@@ -208,21 +454,19 @@ end
                             if (ram_counter >= RAM_SIZE) begin
                                 state <= S_DONE;
                             end else begin
+                                ram_wren_out <= 1'b0; // Uma escrita por pixel, como no VZ05
                                 // Verifica se o pixel atual da RAM está dentro da área da imagem centralizada
-                                if (current_y >= NORMAL_OFFSET_Y && current_y < NORMAL_OFFSET_Y + ROM_IMG_H &&
-                                    current_x >= NORMAL_OFFSET_X && current_x < NORMAL_OFFSET_X + ROM_IMG_W)
+                                if (!fora_area)
                                 begin
                                     // Se estiver na área da imagem, calcula o endereço da ROM correspondente
-                                    src_x_base <= current_x - NORMAL_OFFSET_X;
-                                    src_y_base <= current_y - NORMAL_OFFSET_Y;
+                                    src_x_base <= fonte_x0 + (current_x - area_x1);
+                                    src_y_base <= fonte_y0 + (current_y - area_y1);
                                     state <= S_READ_ROM; // Próximo estado: buscar o pixel da ROM
                                 end 
                                 else begin
-                                    // Se estiver nas bordas, escreve preto diretamente
-                                    ram_wren_out <= 1'b1;
-                                    ram_data_out <= 8'h00;
-                                    ram_addr_out <= ram_counter;
-                                    ram_counter <= ram_counter + 1;
+                                    // Nas bordas, pula para a próxima linha da área
+                                    ram_wren_out <= 1'b0;
+                                    ram_counter <= prox_area;
                                     state <= S_PROCESS_PIXEL; // Continua no mesmo estado
                                 end
                             end
@@ -256,296 +500,299 @@ end
 					 
                 4'b0001: begin
                     //===============================================================
-                    // MEDIA DE BLOCOS
+                    // MEDIA DE BLOCOS (1x, 0.5x, 0.25x)
                     //===============================================================
-              
-                    case (state)
-                        S_IDLE: begin
-                            ram_counter <= 0;
-                            done <= 1'b0;
-                            ram_wren_out <= 1'b0;
-                            state <= S_CLEAR_FRAME;
-                        end
-                        
-                        S_CLEAR_FRAME: begin
+                    // Lê a imagem fonte (ou a ROI) em ordem de varredura, um pixel
+                    // por ciclo, e cada pixel uma única vez. Blocos incompletos na
+                    // borda direita ou inferior da ROI nunca chegam ao fim e são
+                    // descartados, como na divisão inteira da área. md_soma_h soma os pixels do bloco
+                    // na linha atual; ao fim do bloco a soma vai para md_linha[col],
+                    // que acumula as linhas anteriores do mesmo bloco. Na última
+                    // linha do bloco a média arredondada é gravada no framebuffer.
+                    //
+                    //   estágio 0: rom_addr_out = endereço do pixel fonte
+                    //   estágio 1: rom_data_in -> somas -> framebuffer
+
+                    // --- Estágio 1 ---
+                    md_valid1    <= (state == S_MD_STREAM);
+                    ram_wren_out <= 1'b0;
+
+                    if (md_valid1) begin
+                        md_soma_h <= md_soma_h_atual;
+
+                        if (md_fim_x && !md_fim_y) begin
+                            md_linha[md_col] <= md_soma_bloco;
+                        end else if (md_fim_x) begin
+                            // Última linha do bloco: grava a média arredondada
                             ram_wren_out <= 1'b1;
-                            ram_data_out <= 8'h00; // Preto
-                            ram_addr_out <= ram_counter;
-                            
-                            if (ram_counter < RAM_SIZE - 1) begin
-                                ram_counter <= ram_counter + 1;
-                            end else begin
-                                ram_counter <= 0;
-                                ram_wren_out <= 1'b0;
-                                state <= S_PROCESS_PIXEL;
-                            end
-                        end
-                        
-                        S_PROCESS_PIXEL: begin
-                            if (ram_counter >= RAM_SIZE) begin
-                                state <= S_DONE;
-                            end else begin
-                                ram_wren_out <= 1'b0;
-                                
-                                // MODO NORMAL 1X
-                                if (zoom_enable == 3'b000 &&
-                                    current_y >= NORMAL_OFFSET_Y && current_y < NORMAL_OFFSET_Y + ROM_IMG_H &&
-                                    current_x >= NORMAL_OFFSET_X && current_x < NORMAL_OFFSET_X + ROM_IMG_W)
-                                begin
-                                    src_x_base <= current_x - NORMAL_OFFSET_X;
-                                    src_y_base <= current_y - NORMAL_OFFSET_Y;
-                                    state <= S_FETCH_PIXEL_READ;
-                                // MODO ZOOM OUT 0.5X (MÉDIA 2X2)
-                                end else if (zoom_enable == 3'b011 &&
-                                           current_y >= ZOOM_OUT_OFFSET_Y && current_y < ZOOM_OUT_OFFSET_Y + (ROM_IMG_H / 2) &&
-                                           current_x >= ZOOM_OUT_OFFSET_X && current_x < ZOOM_OUT_OFFSET_X + (ROM_IMG_W / 2))
-                                begin
-                                    src_x_base <= (current_x - ZOOM_OUT_OFFSET_X) * 2;
-                                    src_y_base <= (current_y - ZOOM_OUT_OFFSET_Y) * 2;
-                                    state <= S_FETCH_BLOCK_00;
-                                // MODO ZOOM OUT 0.25X (MÉDIA 4X4)
-                                end else if (zoom_enable == 3'b100 &&
-                                           current_y >= ZOOM_OUT_025_OFFSET_Y && current_y < ZOOM_OUT_025_OFFSET_Y + (ROM_IMG_H / 4) &&
-                                           current_x >= ZOOM_OUT_025_OFFSET_X && current_x < ZOOM_OUT_025_OFFSET_X + (ROM_IMG_W / 4))
-                                begin
-                                    src_x_base <= (current_x - ZOOM_OUT_025_OFFSET_X) * 4;
-                                    src_y_base <= (current_y - ZOOM_OUT_025_OFFSET_Y) * 4;
-                                    state <= S_FETCH_16_INIT;
-										  end else if(zoom_enable != 3'b000 && zoom_enable != 3'b011 && zoom_enable != 3'b100 && current_y >= NORMAL_OFFSET_Y && current_y < NORMAL_OFFSET_Y + ROM_IMG_H &&
-                                    current_x >= NORMAL_OFFSET_X && current_x < NORMAL_OFFSET_X + ROM_IMG_W) begin
-												src_x_base <= current_x - NORMAL_OFFSET_X;
-                                    src_y_base <= current_y - NORMAL_OFFSET_Y;
-                                    state <= S_FETCH_PIXEL_READ;
-                                end else begin
-                                    // Fora da área de desenho, apenas avança para o próximo pixel
-                                    ram_counter <= ram_counter + 1;
-                                    state <= S_PROCESS_PIXEL;
-                                end
-                            end
-                        end
-
-                        // --- Lógica para 1x ---
-                        S_FETCH_PIXEL_READ: begin
-                            rom_addr_out <= src_y_base * ROM_IMG_W + src_x_base;
-                            state <= S_WRITE_RAM_AVG;
-                        end
-
-                        // --- Lógica para Média 2x2 (Zoom 0.5x) ---
-                        S_FETCH_BLOCK_00: begin
-                            rom_addr_out <= src_y_base * ROM_IMG_W + src_x_base;
-                            state <= S_FETCH_BLOCK_01;
-                        end
-                        S_FETCH_BLOCK_01: begin
-                            pixel_00 <= rom_data_in;
-                            rom_addr_out <= src_y_base * ROM_IMG_W + (src_x_base + 1);
-                            state <= S_FETCH_BLOCK_10;
-                        end
-                        S_FETCH_BLOCK_10: begin
-                            pixel_01 <= rom_data_in;
-                            rom_addr_out <= (src_y_base + 1) * ROM_IMG_W + src_x_base;
-                            state <= S_FETCH_BLOCK_11;
-                        end
-                        S_FETCH_BLOCK_11: begin
-                            pixel_10 <= rom_data_in;
-                            rom_addr_out <= (src_y_base + 1) * ROM_IMG_W + (src_x_base + 1);
-                            state <= S_CALC_AVERAGE_4;
-                        end
-                        S_CALC_AVERAGE_4: begin
-                            pixel_11 <= rom_data_in;
-                            state <= S_WRITE_RAM_AVG;
-                        end
-
-                        // --- Lógica para Média 4x4 (Zoom 0.25x) ---
-                        S_FETCH_16_INIT: begin
-                            sum_pixels      <= 12'd0;
-                            block_x_counter <= 2'd0;
-                            block_y_counter <= 2'd0;
-                            state           <= S_FETCH_16_SET_ADDR;
+                            ram_addr_out <= (area_y1 + (md_y1 >> zoom_shift)) * RAM_WIDTH +
+                                            area_x1 + md_col;
+                            ram_data_out <= (md_soma_bloco + md_arred) >> {zoom_shift, 1'b0};
                         end
+                    end
 
-                        S_FETCH_16_SET_ADDR: begin
-                            rom_addr_out <= (src_y_base + block_y_counter) * ROM_IMG_W + (src_x_base + block_x_counter);
-                            state        <= S_FETCH_16_READ_ADD;
+                    case (state)
+                        S_IDLE: begin
+                            md_x    <= 0;
+                            md_y    <= 0;
+                            md_addr <= fonte_base;
+                            done    <= 1'b0;
+                            state   <= S_MD_STREAM;
                         end
 
-                        S_FETCH_16_READ_ADD: begin
-                            sum_pixels <= sum_pixels + rom_data_in; // Acumula o valor do pixel
-                            if (block_x_counter == 2'd3) begin
-                                block_x_counter <= 2'd0;
-                                if (block_y_counter == 2'd3) begin
-                                    state <= S_WRITE_RAM_AVG; // Terminou o bloco 4x4
-                                end else begin
-                                    block_y_counter <= block_y_counter + 1;
-                                    state <= S_FETCH_16_SET_ADDR; // Próxima linha
-                                end
+                        // --- Estágio 0 ---
+                        S_MD_STREAM: begin
+                            rom_addr_out <= md_addr;
+                            md_x1        <= md_x;
+                            md_y1        <= md_y;
+
+                            if (md_x == fonte_larg - 1) begin
+                                md_x    <= 0;
+                                md_y    <= md_y + 1;
+                                md_addr <= md_addr + (ROM_IMG_W - fonte_larg + 1);
+                                if (md_y == fonte_alt - 1)
+                                    state <= S_MD_DRAIN;
                             end else begin
-                                block_x_counter <= block_x_counter + 1;
-                                state <= S_FETCH_16_SET_ADDR; // Próxima coluna
+                                md_x    <= md_x + 1;
+                                md_addr <= md_addr + 1;
                             end
                         end
-                        
-                        // --- Estado Comum de Escrita ---
-                        S_WRITE_RAM_AVG: begin
-                            ram_wren_out <= 1'b1;
-                            ram_addr_out <= ram_counter;
-                            
-                            if(zoom_enable == 3'b100) begin // Média 4x4
-                                ram_data_out <= (sum_pixels + 12'd8) >> 4; // (soma)/16 com arredondamento
-                            end else if (zoom_enable == 3'b011) begin // Média 2x2
-                                ram_data_out <= ({2'b0, pixel_00} + {2'b0, pixel_01} + {2'b0, pixel_10} + {2'b0, pixel_11} + 2'd2) >> 2;
-                            end else begin // Modo Normal 1x
-                                ram_data_out <= rom_data_in;
-                            end
-                            
-                            ram_counter <= ram_counter + 1;
-                            state <= S_PROCESS_PIXEL;
+
+                        // O último pixel passa pelo estágio 1 neste ciclo
+                        S_MD_DRAIN: begin
+                            state <= S_DONE;
                         end
-                        
+
                         S_DONE: begin
                             done <= 1'b1;
-                            ram_wren_out <= 1'b0;
                         end
-                        
+
                         default: state <= S_IDLE;
                     endcase
                 end // FIM do case(tipo_alg)
  // FIM MEDIA BLOCOS ===============================================
 
-               4'b0010: begin
+               4'b0010, 4'b0100, 4'b0110: begin
     //====================================================================
-    //==== VIZINHO MAIS PRÓXIMO (ZOOM IN 1x, 2x, 4x)
+    //==== VIZINHO MAIS PRÓXIMO / REPLICAÇÃO (ZOOM IN 1x, 2x, 4x)
+    //==== ESCALA DDA (FATOR QUALQUER)
     //====================================================================
+    // Varre só a área ativa, um pixel por ciclo: cada ciclo emite um
+    // endereço de ROM e grava um pixel no framebuffer. As bordas ficam
+    // pretas pelo estágio de saída do VGA, sem escrita.
+    //
+    //   estágio 0: nn_x/nn_y (pixel da tela) e ram_counter
+    //   estágio 1: coordenadas na imagem fonte (subtrai offset, desloca,
+    //              soma a origem da ROI)
+    //   estágio 2: rom_addr_out = sy*160 + sx
+    //   estágio 3: rom_data_in -> framebuffer
+    //
+    // Vizinho mais próximo e replicação geram o mesmo resultado.
+    //
+    // Na escala o estágio 0 acumula os passos 16.16 (esc_x += passo_x a
+    // cada pixel, esc_y += passo_y a cada linha) e o estágio 1 usa a parte
+    // inteira. Antes a área é medida (S_ESC_MEDIDA). Com passo 0x8000 ou
+    // 0x20000 o resultado é o do vizinho 2x ou 0.5x.
+
+    // --- Estágio 1 ---
+    nn_valid1  <= (state == S_NN_STREAM);
+    nn_sx      <= fonte_x0 + ((tipo_alg == 4'b0110) ? esc_x[23:16] : (nn_x - area_x1) >> zoom_shift);
+    nn_sy      <= fonte_y0 + ((tipo_alg == 4'b0110) ? esc_y[22:16] : (nn_y - area_y1) >> zoom_shift);
+    nn_dest1   <= ram_counter;
+
+    // --- Estágio 2 ---
+    nn_valid2    <= nn_valid1;
+    nn_dest2     <= nn_dest1;
+    rom_addr_out <= {nn_sy, 7'b0} + {nn_sy, 5'b0} + nn_sx; // sy*160 + sx
+
+    // --- Estágio 3 ---
+    ram_wren_out <= nn_valid2;
+    ram_addr_out <= nn_dest2;
+    ram_data_out <= rom_data_in;
+
     case (state)
         S_IDLE: begin
-            pixel_counter <= 0;
-            ram_counter   <= 0;
-            zoom_phase    <= 0;
-            done          <= 1'b0;
-            ram_wren_out  <= 1'b0;
-
-            if (zoom_enable == 3'b000) begin
-                // Modo 1x: limpa apenas as bordas
-                state <= S_CLEAR_BORDERS;
-            end else begin
-                // <<< MUDANÇA AQUI
-                // Modos 2x e 4x: limpa a tela inteira antes de desenhar
-                state <= S_CLEAR_ALL;
-            end
+            nn_x        <= area_x1;
+            nn_y        <= area_y1;
+            ram_counter <= area_y1 * RAM_WIDTH + area_x1;
+            esc_x       <= 0;
+            esc_y       <= 0;
+            esc_acc_x   <= 0;
+            esc_acc_y   <= 0;
+            esc_larg    <= 0;
+            esc_alt     <= 0;
+            done        <= 1'b0;
+            state       <= (tipo_alg == 4'b0110) ? S_ESC_MEDIDA : S_NN_STREAM;
         end
 
-        // <<< NOVO ESTADO ADICIONADO
-        // Limpa toda a RAM para os modos 2x e 4x
-        S_CLEAR_ALL: begin
-            ram_wren_out <= 1'b1;
-            ram_data_out <= 8'h00; // Preto
-            ram_addr_out <= ram_counter;
-
-            if (ram_counter < RAM_SIZE - 1) begin
-                ram_counter <= ram_counter + 1;
-            end else begin
-                // Terminou de limpar, prepara para desenhar
-                ram_counter   <= 0;
-                pixel_counter <= 0;
-                state         <= S_SET_ADDR;
+        // Um ciclo por pixel da maior dimensão; a área é capturada no
+        // ciclo em que as duas contagens param (esc_medida_pronta)
+        S_ESC_MEDIDA: begin
+            if (esc_cont_x) begin
+                esc_larg  <= esc_larg + 1;
+                esc_acc_x <= esc_acc_x + esc_passo_x;
+            end
+            if (esc_cont_y) begin
+                esc_alt   <= esc_alt + 1;
+                esc_acc_y <= esc_acc_y + esc_passo_y;
             end
+            if (!esc_cont_x && !esc_cont_y)
+                state <= S_ESC_INICIO;
         end
 
-        S_CLEAR_BORDERS: begin
-            // Lógica para limpar bordas (apenas para o modo 1x)
-            if (current_y < NO_ZOOM_OFFSET_Y ||
-                current_y >= NO_ZOOM_OFFSET_Y + ROM_IMG_H ||
-                current_x < NO_ZOOM_OFFSET_X ||
-                current_x >= NO_ZOOM_OFFSET_X + ROM_IMG_W) begin
+        S_ESC_INICIO: begin
+            nn_x        <= area_x1;
+            nn_y        <= area_y1;
+            ram_counter <= area_y1 * RAM_WIDTH + area_x1;
+            state       <= S_NN_STREAM;
+        end
 
-                ram_wren_out <= 1'b1;
-                ram_data_out <= 8'h00; // Preto
-                ram_addr_out <= ram_counter;
+        S_NN_STREAM: begin
+            if (nn_x == area_x2 - 1) begin
+                nn_x <= area_x1;
+                nn_y <= nn_y + 1;
+                esc_x <= 0;
+                esc_y <= esc_y + esc_passo_y[22:0];
+                ram_counter <= ram_counter + area_salto;
+                if (nn_y == area_y2 - 1)
+                    state <= S_NN_DRAIN;
             end else begin
-                ram_wren_out <= 1'b0;
-            end
-
-            if (ram_counter < RAM_SIZE - 1) begin
+                nn_x <= nn_x + 1;
+                esc_x <= esc_x + esc_passo_x[23:0];
                 ram_counter <= ram_counter + 1;
-            end else begin
-                // Terminou de limpar, reseta o contador para desenhar a imagem
-                pixel_counter <= 0;
-                state         <= S_SET_ADDR;
             end
         end
 
-        S_SET_ADDR: begin
-            rom_addr_out <= pixel_counter;
-            state        <= S_READ_ROM;
+        // Espera o último pixel atravessar os estágios 1 e 2
+        S_NN_DRAIN: begin
+            if (!nn_valid1)
+                state <= S_DONE;
         end
 
-        S_READ_ROM: begin
-            rom_data_reg <= rom_data_in;
-            state        <= S_WRITE_RAM;
+        S_DONE: begin
+            done <= 1'b1;
         end
 
-        S_WRITE_RAM: begin
-            ram_wren_out <= 1'b1;
-            ram_data_out <= rom_data_reg;
-
-            if (zoom_enable == 3'b010) begin // MODO ZOOM 4X
-                ram_addr_out <= ((rom_y * 4) + local_offset_y + ZOOM4X_OFFSET_Y) * RAM_WIDTH +
-                                ((rom_x * 4) + local_offset_x + ZOOM4X_OFFSET_X);
-
-                if (zoom_phase == 4'b1111) begin
-                    zoom_phase <= 4'b0000;
-                    if (pixel_counter < ROM_SIZE - 1) begin
-                        pixel_counter <= pixel_counter + 1;
-                        state <= S_SET_ADDR;
-                    end else begin
-                        state <= S_DONE;
-                    end
-                end else begin
-                    zoom_phase <= zoom_phase + 1;
-                    state <= S_WRITE_RAM;
-                end
+        default: state <= S_IDLE;
+    endcase
+end // FIM VIZINHO MAIS PRÓXIMO / REPLICAÇÃO ======================================
 
-            end else if (zoom_enable == 3'b001) begin // MODO ZOOM 2X
-                case(zoom_phase[1:0])
-                    2'b00: ram_addr_out <= ((rom_y * 2) + 0 + ZOOM_OFFSET_Y) * RAM_WIDTH + ((rom_x * 2) + 0 + ZOOM_OFFSET_X);
-                    2'b01: ram_addr_out <= ((rom_y * 2) + 0 + ZOOM_OFFSET_Y) * RAM_WIDTH + ((rom_x * 2) + 1 + ZOOM_OFFSET_X);
-                    2'b10: ram_addr_out <= ((rom_y * 2) + 1 + ZOOM_OFFSET_Y) * RAM_WIDTH + ((rom_x * 2) + 0 + ZOOM_OFFSET_X);
-                    2'b11: ram_addr_out <= ((rom_y * 2) + 1 + ZOOM_OFFSET_Y) * RAM_WIDTH + ((rom_x * 2) + 1 + ZOOM_OFFSET_X);
-                endcase
-
-                if (zoom_phase[1:0] == 2'b11) begin
-                    zoom_phase <= 4'b0000;
-                    if (pixel_counter < ROM_SIZE - 1) begin
-                        pixel_counter <= pixel_counter + 1;
-                        state <= S_SET_ADDR;
-                    end else begin
-                        state <= S_DONE;
-                    end
-                end else begin
-                    zoom_phase <= zoom_phase + 1;
-                    state <= S_WRITE_RAM;
-                end
+               4'b0101: begin
+    //====================================================================
+    //==== INTERPOLAÇÃO BILINEAR (ZOOM IN 1x, 2x, 4x)
+    //====================================================================
+    // Varre a área ativa um pixel por ciclo. A linha superior (y0) de cada
+    // pixel vem de um banco de linha; a inferior (y1) é lida da ROM, que
+    // não tem outro uso, e copiada para o outro banco para servir de linha
+    // superior quando y0 avança. Só a primeira linha é carregada antes.
+    //
+    //   estágio 0: bl_x/bl_y, rom_addr_out = (x1, y1)
+    //   estágio 1: 4 vizinhos -> interpolação horizontal
+    //   estágio 2: interpolação vertical, arredondada -> framebuffer
+    //
+    // out = ((4-fy4)*((4-fx4)*a + fx4*b) + fy4*((4-fx4)*c + fx4*d) + 8) >> 4
+
+    // --- Estágio 1 ---
+    bl_valid2 <= bl_valid1;
+    bl_dest2  <= bl_dest1;
+    bl_fy4_2  <= bl_fy4_1;
+
+    if (bl_valid1) begin
+        bl_h_sup <= (3'd4 - bl_fx4_1) * bl_sup_esq + bl_fx4_1 * bl_sup_dir;
+        bl_h_inf <= (3'd4 - bl_fx4_1) * bl_inf_esq + bl_fx4_1 * bl_inf_dir;
+
+        // Fim do bloco: a linha inferior vira superior do próximo grupo de
+        // linhas, e o pixel (x1, y1) lido é o inferior esquerdo do próximo bloco
+        if (bl_ultima_1) begin
+            if (bl_banco_1)
+                bl_linha0[bl_x0_1] <= bl_q0;
+            else
+                bl_linha1[bl_x0_1] <= bl_q0;
+            bl_q0 <= rom_data_in;
+        end
+    end
 
-            end else begin // MODO SEM ZOOM (1X)
-                ram_addr_out <= (rom_y + NO_ZOOM_OFFSET_Y) * RAM_WIDTH +
-                                (rom_x + NO_ZOOM_OFFSET_X);
+    // --- Estágio 2 ---
+    ram_wren_out <= bl_valid2;
+    ram_addr_out <= bl_dest2;
+    ram_data_out <= ((3'd4 - bl_fy4_2) * bl_h_sup + bl_fy4_2 * bl_h_inf + 12'd8) >> 4;
 
-                if (pixel_counter < ROM_SIZE - 1) begin
-                    pixel_counter <= pixel_counter + 1;
-                    state <= S_SET_ADDR;
-                end else begin
-                    state <= S_DONE;
-                end
+    case (state)
+        S_IDLE: begin
+            bl_x         <= 0;
+            bl_y         <= 0;
+            bl_cx        <= 0;
+            bl_banco     <= 1'b0;
+            bl_valid1    <= 1'b0;
+            rom_addr_out <= fonte_base;
+            ram_counter  <= area_y1 * RAM_WIDTH + area_x1;
+            done         <= 1'b0;
+            state        <= S_BL_CARGA;
+        end
+
+        // Linha 0 da fonte no banco superior
+        S_BL_CARGA: begin
+            if (bl_banco)
+                bl_linha1[bl_cx] <= rom_data_in;
+            else
+                bl_linha0[bl_cx] <= rom_data_in;
+            bl_cx <= bl_cx + 1;
+
+            if (bl_cx == fonte_larg - 1) begin
+                // (0, y1 da linha 0): inferior esquerdo do primeiro bloco
+                rom_addr_out <= fonte_base + ((fonte_alt == 1) ? 0 : ROM_IMG_W);
+                state        <= S_BL_Q0;
+            end else begin
+                rom_addr_out <= fonte_base + bl_cx + 1;
             end
         end
 
+        S_BL_Q0: begin
+            bl_q0 <= rom_data_in;
+            state <= S_BL_STREAM;
+        end
+
+        // --- Estágio 0 ---
+        S_BL_STREAM: begin
+            rom_addr_out <= bl_rom_addr;
+            bl_x0_1      <= bl_x0;
+            bl_x1_1      <= bl_x1;
+            bl_fx4_1     <= bl_fx4;
+            bl_fy4_1     <= bl_fy4;
+            bl_ultima_1  <= (bl_fx == zoom_mascara);
+            bl_borda_1   <= bl_borda;
+            bl_banco_1   <= bl_banco;
+            bl_dest1     <= ram_counter;
+            bl_valid1    <= 1'b1;
+
+            if (bl_x == area_larg - 1) begin
+                bl_x        <= 0;
+                bl_y        <= bl_y + 1;
+                ram_counter <= ram_counter + area_salto;
+                if (bl_fy == zoom_mascara)
+                    bl_banco <= ~bl_banco; // y0 avança: a linha copiada vira a superior
+                if (bl_y == area_alt - 1)
+                    state <= S_BL_DRAIN;
+            end else begin
+                bl_x        <= bl_x + 1;
+                ram_counter <= ram_counter + 1;
+            end
+        end
+
+        // Espera o último pixel atravessar os estágios 1 e 2
+        S_BL_DRAIN: begin
+            bl_valid1 <= 1'b0;
+            if (!bl_valid1)
+                state <= S_DONE;
+        end
+
         S_DONE: begin
             done <= 1'b1;
-            ram_wren_out <= 1'b0;
         end
 
         default: state <= S_IDLE;
     endcase
-end // FIM VIZINHO MAIS PRÓXIMO ===============================================
+end // FIM BILINEAR ==================================================================
        
                4'b0011: begin 
 							 // =================================================================================================
@@ -556,21 +803,7 @@ end // FIM VIZINHO MAIS PRÓXIMO ===============================================
 										ram_counter <= 0;
 										done <= 1'b0;
 										ram_wren_out <= 1'b0;
-										state <= VZ05_CLEAR_FRAME; // Limpa a tela inteira primeiro
-								  end
-								  
-								  VZ05_CLEAR_FRAME: begin
-										ram_wren_out <= 1'b1;
-										ram_data_out <= 8'h00; // Preto
-										ram_addr_out <= ram_counter;
-										
-										if (ram_counter < RAM_SIZE - 1) begin
-											 ram_counter <= ram_counter + 1;
-										end else begin
-											 ram_counter <= 0;
-											 ram_wren_out <= 1'b0;
-											 state <= VZ05_PROCESS_PIXEL;
-										end
+										state <= VZ05_PROCESS_PIXEL;
 								  end
 								  
 								  VZ05_PROCESS_PIXEL: begin
@@ -579,67 +812,19 @@ end // FIM VIZINHO MAIS PRÓXIMO ===============================================
 										end else begin
 											 ram_wren_out <= 1'b0;
 											 
-											 // --- MODO ZOOM OUT 0.5x ---
-											 if (zoom_enable == 3'b011) begin 
-												  if (current_y >= ZOOM_OUT_OFFSET_Y && current_y < ZOOM_OUT_OFFSET_Y + (ROM_IMG_H / 2) &&
-														current_x >= ZOOM_OUT_OFFSET_X && current_x < ZOOM_OUT_OFFSET_X + (ROM_IMG_W / 2)) begin
-														
-														temp_x = (current_x - ZOOM_OUT_OFFSET_X) * 2;
-														temp_y = (current_y - ZOOM_OUT_OFFSET_Y) * 2;
-														
-														src_x <= temp_x[7:0];
-														src_y <= temp_y[6:0];
-														
-														state <= VZ05_SET_ROM_ADDR;
-												  end else begin
-														// Fora da área de desenho, apenas avança para o próximo pixel
-														ram_counter <= ram_counter + 1;
-														state <= VZ05_PROCESS_PIXEL;
-												  end
-											 
-											 // --- NOVO MODO ZOOM OUT 0.25x ---
-											 end else if (zoom_enable == 3'b0100) begin
-												  if (current_y >= ZOOM_OUT_025_OFFSET_Y && current_y < ZOOM_OUT_025_OFFSET_Y + (ROM_IMG_H / 4) &&
-														current_x >= ZOOM_OUT_025_OFFSET_X && current_x < ZOOM_OUT_025_OFFSET_X + (ROM_IMG_W / 4)) begin
-														
-														temp_x = (current_x - ZOOM_OUT_025_OFFSET_X) * 4;
-														temp_y = (current_y - ZOOM_OUT_025_OFFSET_Y) * 4;
-														
-														src_x <= temp_x[7:0];
-														src_y <= temp_y[6:0];
-														
-														state <= VZ05_SET_ROM_ADDR;
-												  end else begin
-														// Fora da área de desenho, apenas avança para o próximo pixel
-														ram_counter <= ram_counter + 1;
-														state <= VZ05_PROCESS_PIXEL;
-												  end
-
-											 // --- MODO NORMAL 1:1 ---
-											 end else if (zoom_enable == 3'b000) begin
-												  if (current_y >= NORMAL_OFFSET_Y && current_y < NORMAL_OFFSET_Y + ROM_IMG_H &&
-														current_x >= NORMAL_OFFSET_X && current_x < NORMAL_OFFSET_X + ROM_IMG_W) begin
-														
-														src_x <= current_x - NORMAL_OFFSET_X;
-														src_y <= current_y - NORMAL_OFFSET_Y;
-														
-														state <= VZ05_SET_ROM_ADDR;
-												  end else begin
-														ram_counter <= ram_counter + 1;
-														state <= VZ05_PROCESS_PIXEL;
-												  end
+											 // Um pixel da área a cada 2^zoom_shift da fonte (0.5x, 0.25x, 1x)
+											 if (!fora_area) begin
+												  temp_x = (current_x - area_x1) << zoom_shift;
+												  temp_y = (current_y - area_y1) << zoom_shift;
+
+												  src_x <= fonte_x0 + temp_x[7:0];
+												  src_y <= fonte_y0 + temp_y[6:0];
+
+												  state <= VZ05_SET_ROM_ADDR;
 											 end else begin
-												  if (current_y >= NORMAL_OFFSET_Y && current_y < NORMAL_OFFSET_Y + ROM_IMG_H &&
-														current_x >= NORMAL_OFFSET_X && current_x < NORMAL_OFFSET_X + ROM_IMG_W) begin
-														
-														src_x <= current_x - NORMAL_OFFSET_X;
-														src_y <= current_y - NORMAL_OFFSET_Y;
-														
-														state <= VZ05_SET_ROM_ADDR;
-												  end else begin
-														ram_counter <= ram_counter + 1;
-														state <= VZ05_PROCESS_PIXEL;
-												  end
+												  // Fora da área de desenho, pula para a próxima linha da área
+												  ram_counter <= prox_area;
+												  state <= VZ05_PROCESS_PIXEL;
 											 end
 										end
 								  end
@@ -671,140 +856,6 @@ end // FIM VIZINHO MAIS PRÓXIMO ===============================================
 							 endcase
 						end // END VIZINHO 0.5X ===================================================================
                 
-                4'b0100: begin 
-
-							 //====================================================================
-							 //==== ALGORITMO DE REPLICAÇÃO DE PIXELS (1x, 2x, 4x)
-							 //====================================================================
-
-							 case (state)
-
-								  S_IDLE: begin
-										pixel_counter <= 0;
-										ram_counter   <= 0;
-										zoom_phase    <= 0;
-										done          <= 1'b0;
-										ram_wren_out  <= 1'b0;
-
-										if (zoom_enable == 3'b000) begin
-											 // 1x → apenas bordas
-											 state <= S_CLEAR_BORDERS;
-										end else begin
-											 // 2x e 4x → limpar tudo antes de desenhar
-											 state <= S_CLEAR_ALL;
-										end
-								  end
-
-								  // NOVO ESTADO: limpa toda a RAM em 2x e 4x
-								  S_CLEAR_ALL: begin
-										ram_wren_out <= 1'b1;
-										ram_data_out <= 8'h00; // Preto
-										ram_addr_out <= ram_counter;
-
-										if (ram_counter < RAM_SIZE - 1) begin
-											 ram_counter <= ram_counter + 1;
-										end else begin
-											 ram_counter <= 0;
-											 pixel_counter <= 0;
-											 state <= S_SET_ADDR; // Começa a desenhar a imagem
-										end
-								  end
-
-								  S_CLEAR_BORDERS: begin
-										// Limpa apenas as bordas no modo 1x
-										if (current_y < NO_ZOOM_OFFSET_Y || 
-											 current_y >= NO_ZOOM_OFFSET_Y + ROM_IMG_H ||
-											 current_x < NO_ZOOM_OFFSET_X || 
-											 current_x >= NO_ZOOM_OFFSET_X + ROM_IMG_W) begin
-
-											 ram_wren_out <= 1'b1;
-											 ram_data_out <= 8'h00; // Preto
-											 ram_addr_out <= ram_counter;
-										end else begin
-											 ram_wren_out <= 1'b0;
-										end
-
-										if (ram_counter < RAM_SIZE - 1) begin
-											 ram_counter <= ram_counter + 1;
-										end else begin
-											 pixel_counter <= 0; // Prepara para desenhar a imagem no centro
-											 state         <= S_SET_ADDR;
-										end
-								  end
-
-								  S_SET_ADDR: begin
-										rom_addr_out <= pixel_counter;
-										state        <= S_READ_ROM;
-								  end
-
-								  S_READ_ROM: begin
-										rom_data_reg <= rom_data_in;
-										state        <= S_WRITE_RAM;
-								  end
-
-								  S_WRITE_RAM: begin
-										ram_wren_out <= 1'b1;
-										ram_data_out <= rom_data_reg;
-
-										if (zoom_enable == 3'b010) begin // MODO 4X
-											 ram_addr_out <= ((rom_y * 4) + local_offset_y + ZOOM4X_OFFSET_Y) * RAM_WIDTH + 
-																  ((rom_x * 4) + local_offset_x + ZOOM4X_OFFSET_X);
-
-											 if (zoom_phase == 4'b1111) begin
-												  zoom_phase <= 4'b0000;
-												  if (pixel_counter < ROM_SIZE - 1) begin
-														pixel_counter <= pixel_counter + 1;
-														state <= S_SET_ADDR;
-												  end else begin
-														state <= S_DONE;
-												  end
-											 end else begin
-												  zoom_phase <= zoom_phase + 1;
-												  state <= S_WRITE_RAM;
-											 end
-
-										end else if (zoom_enable == 3'b001) begin // MODO 2X
-											 case(zoom_phase[1:0])
-												  2'b00: ram_addr_out <= ((rom_y * 2) + 0 + ZOOM_OFFSET_Y) * RAM_WIDTH + ((rom_x * 2) + 0 + ZOOM_OFFSET_X);
-												  2'b01: ram_addr_out <= ((rom_y * 2) + 0 + ZOOM_OFFSET_Y) * RAM_WIDTH + ((rom_x * 2) + 1 + ZOOM_OFFSET_X);
-												  2'b10: ram_addr_out <= ((rom_y * 2) + 1 + ZOOM_OFFSET_Y) * RAM_WIDTH + ((rom_x * 2) + 0 + ZOOM_OFFSET_X);
-												  2'b11: ram_addr_out <= ((rom_y * 2) + 1 + ZOOM_OFFSET_Y) * RAM_WIDTH + ((rom_x * 2) + 1 + ZOOM_OFFSET_X);
-											 endcase
-
-											 if (zoom_phase[1:0] == 2'b11) begin
-												  zoom_phase <= 4'b0000;
-												  if (pixel_counter < ROM_SIZE - 1) begin
-														pixel_counter <= pixel_counter + 1;
-														state <= S_SET_ADDR;
-												  end else begin
-														state <= S_DONE;
-												  end
-											 end else begin
-												  zoom_phase <= zoom_phase + 1;
-												  state <= S_WRITE_RAM;
-											 end
-
-										end else begin // MODO 1X
-											 ram_addr_out <= (rom_y + NO_ZOOM_OFFSET_Y) * RAM_WIDTH + (rom_x + NO_ZOOM_OFFSET_X);
-
-											 if (pixel_counter < ROM_SIZE - 1) begin
-												  pixel_counter <= pixel_counter + 1;
-												  state <= S_SET_ADDR;
-											 end else begin
-												  state <= S_DONE;
-											 end
-										end
-								  end
-
-								  S_DONE: begin
-										done <= 1'b1;
-										ram_wren_out <= 1'b0;
-								  end
-
-								  default: state <= S_IDLE;
-
-							 endcase
-						end // FIM REPLICAÇÃO (1x, 2x, 4x)// FIM REPLICAÇÃO 2X
 						
 						
 						4'b1111: begin
@@ -820,21 +871,19 @@ end // FIM VIZINHO MAIS PRÓXIMO ===============================================
                             if (ram_counter >= RAM_SIZE) begin
                                 state <= S_DONE;
                             end else begin
+                                ram_wren_out <= 1'b0; // Uma escrita por pixel, como no VZ05
                                 // Verifica se o pixel atual da RAM está dentro da área da imagem centralizada
-                                if (current_y >= NORMAL_OFFSET_Y && current_y < NORMAL_OFFSET_Y + ROM_IMG_H &&
-                                    current_x >= NORMAL_OFFSET_X && current_x < NORMAL_OFFSET_X + ROM_IMG_W)
+                                if (!fora_area)
                                 begin
                                     // Se estiver na área da imagem, calcula o endereço da ROM correspondente
-                                    src_x_base <= current_x - NORMAL_OFFSET_X;
-                                    src_y_base <= current_y - NORMAL_OFFSET_Y;
+                                    src_x_base <= fonte_x0 + (current_x - area_x1);
+                                    src_y_base <= fonte_y0 + (current_y - area_y1);
                                     state <= S_READ_ROM; // Próximo estado: buscar o pixel da ROM
                                 end 
                                 else begin
-                                    // Se estiver nas bordas, escreve preto diretamente
-                                    ram_wren_out <= 1'b1;
-                                    ram_data_out <= 8'h00;
-                                    ram_addr_out <= ram_counter;
-                                    ram_counter <= ram_counter + 1;
+                                    // Nas bordas, pula para a próxima linha da área
+                                    ram_wren_out <= 1'b0;
+                                    ram_counter <= prox_area;
                                     state <= S_PROCESS_PIXEL; // Continua no mesmo estado
                                 end
                             end
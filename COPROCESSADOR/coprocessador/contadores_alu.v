@@ -0,0 +1,111 @@
+// ========================================================================
+// contadores_alu.v - Banco de contadores de desempenho da ALU
+//
+// Observa alu_algoritmos de fora, no domínio de clk25, e guarda o custo
+// de cada operação para o HPS ler pelo par de PIOs:
+//   pio_contador_sel (0x180B0): índice do contador
+//   pio_contador     (0x180C0): valor do contador selecionado
+//
+// Índices:
+//   0 = ciclos da operação (cópia de pio_status[31:2])
+//   1 = ciclos de limpeza (cópia de pio_limpeza)
+//   2 = leituras da ROM (dados de rom_data_in consumidos)
+//   3 = escritas no framebuffer (ciclos com ram_wren)
+//   4 = latência do start ao done, em ciclos de clk25
+//   5 = operações concluídas desde a configuração da FPGA
+//   6 = operações abortadas por um novo start antes do done
+//
+// Os contadores 2..4 zeram a cada start; 5 e 6 só no reset do sistema.
+// Todos saturam em vez de voltar a zero. Diferente de cycle_count, a
+// latência começa na subida do pulso de start (o reset da ALU), então
+// inclui a largura do pulso escrito pelo HPS.
+// ========================================================================
+
+module contadores_alu (
+    input  wire        clk,
+    input  wire        reset,          // reset do sistema (ativo em alto)
+
+    // Sinais da ALU
+    input  wire        start,          // pio_reset_alu (domínio do HPS)
+    input  wire        done,           // status_data_out[0]
+    input  wire        rom_leitura,    // rom_leitura_out
+    input  wire        ram_wren,       // ram_wren_out
+    input  wire [29:0] ciclos,         // status_data_out[31:2]
+    input  wire [29:0] ciclos_limpeza, // limpeza_data_out[29:0]
+
+    // Leitura pelo HPS
+    input  wire [2:0]  sel,
+    output reg  [31:0] valor
+);
+
+    localparam MAXIMO = 32'hFFFFFFFF;
+
+    // --- Pulso de start ---
+    // O PIO vive no clock do barramento: sincroniza antes de detectar a borda
+    reg [2:0] start_sinc;
+    reg       done_ant;
+    always @(posedge clk) begin
+        start_sinc <= {start_sinc[1:0], start};
+        done_ant   <= done;
+    end
+
+    wire start_subida = start_sinc[1] && !start_sinc[2];
+    wire done_subida  = done && !done_ant;
+
+    reg        em_execucao;
+    reg [31:0] leituras_rom;
+    reg [31:0] escritas_fb;
+    reg [31:0] latencia;
+    reg [31:0] concluidas;
+    reg [31:0] abortadas;
+
+    always @(posedge clk or posedge reset) begin
+        if (reset) begin
+            em_execucao  <= 1'b0;
+            leituras_rom <= 32'd0;
+            escritas_fb  <= 32'd0;
+            latencia     <= 32'd0;
+            concluidas   <= 32'd0;
+            abortadas    <= 32'd0;
+        end else if (start_subida) begin
+            // Start com a operação anterior ainda em curso: ela nunca termina
+            if (em_execucao && abortadas != MAXIMO)
+                abortadas <= abortadas + 32'd1;
+            em_execucao  <= 1'b1;
+            leituras_rom <= 32'd0;
+            escritas_fb  <= 32'd0;
+            latencia     <= 32'd0;
+        end else begin
+            if (rom_leitura && leituras_rom != MAXIMO)
+                leituras_rom <= leituras_rom + 32'd1;
+            if (ram_wren && escritas_fb != MAXIMO)
+                escritas_fb <= escritas_fb + 32'd1;
+
+            // done fica em 0 durante o pulso: a subida marca o fim desta operação
+            if (em_execucao) begin
+                if (done_subida) begin
+                    em_execucao <= 1'b0;
+                    if (concluidas != MAXIMO)
+                        concluidas <= concluidas + 32'd1;
+                end else if (latencia != MAXIMO) begin
+                    latencia <= latencia + 32'd1;
+                end
+            end
+        end
+    end
+
+    // --- Multiplexador de leitura ---
+    always @(posedge clk) begin
+        case (sel)
+            3'd0:    valor <= {2'b00, ciclos};
+            3'd1:    valor <= {2'b00, ciclos_limpeza};
+            3'd2:    valor <= leituras_rom;
+            3'd3:    valor <= escritas_fb;
+            3'd4:    valor <= latencia;
+            3'd5:    valor <= concluidas;
+            3'd6:    valor <= abortadas;
+            default: valor <= 32'd0;
+        endcase
+    end
+
+endmodule
@@ -0,0 +1,125 @@
+// ========================================================================
+// overlay_vga.v - Cursor e janela de seleção sobrepostos ao pixel do VGA
+//
+// Fica entre a saída do framebuffer (blocoram) e o vga_driver. As formas
+// são desenhadas a partir de registradores escritos pelo HPS, então mover
+// o cursor não exige alterar a imagem nem rodar a ALU.
+//
+// Também pinta de preto o que está fora da área ativa da última operação
+// da ALU (area_ini/area_fim), o que dispensa limpar o framebuffer.
+//
+// Coordenadas em pixels da tela (640x480):
+//   cursor_cfg = {reservado[31:21], visivel[20], y[19:10], x[9:0]}
+//   janela_ini = {reservado[31:22], modo[21:20], y1[19:10], x1[9:0]}
+//   janela_fim = {reservado[31:20],              y2[19:10], x2[9:0]}
+//
+// modo: 0 = oculta, 1 = retângulo (x1,y1)-(x2,y2),
+//       2 = canto em L com vértice em (x1,y1) e braços até x2 e y2
+// ========================================================================
+
+module overlay_vga #(
+    parameter CURSOR_TAM = 5,   // Meio comprimento dos braços da cruz
+    parameter ESPESSURA  = 2    // Espessura da borda do retângulo
+)(
+    input  wire        clk,
+
+    // Coordenadas do próximo pixel (vga_driver)
+    input  wire [9:0]  next_x,
+    input  wire [9:0]  next_y,
+
+    // Pixel lido do framebuffer para next_x/next_y
+    input  wire [7:0]  pixel_in,
+
+    // Área ativa da ALU: {y[19:10], x[9:0]}, canto final exclusivo
+    input  wire [19:0] area_ini,
+    input  wire [19:0] area_fim,
+
+    // Registradores do HPS (pio_cursor, pio_janela_ini, pio_janela_fim)
+    input  wire [31:0] cursor_cfg,
+    input  wire [31:0] janela_ini,
+    input  wire [31:0] janela_fim,
+
+    output wire [7:0]  pixel_out
+);
+
+    localparam BRANCO = 8'd255;
+    localparam PRETO  = 8'd0;
+
+    localparam MODO_OCULTA     = 2'd0;
+    localparam MODO_RETANGULO  = 2'd1;
+    localparam MODO_CANTO      = 2'd2;
+
+    // --- Alinhamento com a RAM ---
+    // blocoram registra endereço e saída: pixel_in chega 2 ciclos depois
+    // de next_x/next_y, então as coordenadas passam pelo mesmo atraso
+    reg [9:0] x_d1, y_d1, px, py;
+    always @(posedge clk) begin
+        x_d1 <= next_x;
+        y_d1 <= next_y;
+        px   <= x_d1;
+        py   <= y_d1;
+    end
+
+    // --- Campos dos registradores ---
+    wire [9:0] cursor_x   = cursor_cfg[9:0];
+    wire [9:0] cursor_y   = cursor_cfg[19:10];
+    wire       cursor_vis = cursor_cfg[20];
+
+    wire [9:0] jx1  = janela_ini[9:0];
+    wire [9:0] jy1  = janela_ini[19:10];
+    wire [1:0] modo = janela_ini[21:20];
+    wire [9:0] jx2  = janela_fim[9:0];
+    wire [9:0] jy2  = janela_fim[19:10];
+
+    // --- Área ativa: fora dela o framebuffer tem restos de operações antigas ---
+    wire dentro_area = (px >= area_ini[9:0])   && (px < area_fim[9:0]) &&
+                       (py >= area_ini[19:10]) && (py < area_fim[19:10]);
+    wire [7:0] pixel_base = dentro_area ? pixel_in : PRETO;
+
+    // --- Cursor: cruz branca com borda preta ---
+    wire signed [11:0] cdx = $signed({2'b00, px}) - $signed({2'b00, cursor_x});
+    wire signed [11:0] cdy = $signed({2'b00, py}) - $signed({2'b00, cursor_y});
+    wire [11:0] cdx_abs = cdx[11] ? -cdx : cdx;
+    wire [11:0] cdy_abs = cdy[11] ? -cdy : cdy;
+
+    wire cursor_vert  = cursor_vis && (cdx_abs <= 12'd1) && (cdy_abs <= CURSOR_TAM);
+    wire cursor_horiz = cursor_vis && (cdy_abs <= 12'd1) && (cdx_abs <= CURSOR_TAM);
+
+    // Como em desenhar_cursor(): a barra vertical é desenhada por cima
+    wire       cursor_hit = cursor_vert || cursor_horiz;
+    wire [7:0] cursor_cor = cursor_vert ? ((cdx == 12'sd0) ? BRANCO : PRETO)
+                                        : ((cdy == 12'sd0) ? BRANCO : PRETO);
+
+    // --- Retângulo de seleção: borda branca de ESPESSURA pixels ---
+    wire dentro_ret = (px >= jx1) && (px <= jx2) && (py >= jy1) && (py <= jy2);
+    wire borda_ret  = (px < jx1 + ESPESSURA) || (px + ESPESSURA > jx2) ||
+                      (py < jy1 + ESPESSURA) || (py + ESPESSURA > jy2);
+    wire ret_hit    = (modo == MODO_RETANGULO) && dentro_ret && borda_ret;
+
+    // --- Canto em L (primeiro ponto da seleção) ---
+    wire signed [11:0] kdx = $signed({2'b00, px}) - $signed({2'b00, jx1});
+    wire signed [11:0] kdy = $signed({2'b00, py}) - $signed({2'b00, jy1});
+    wire [11:0] kdx_abs = kdx[11] ? -kdx : kdx;
+    wire [11:0] kdy_abs = kdy[11] ? -kdy : kdy;
+    wire [11:0] braco_x = {2'b00, jx2} - {2'b00, jx1};
+    wire [11:0] braco_y = {2'b00, jy2} - {2'b00, jy1};
+
+    // Faixa [-1, braço] de cada eixo (12'hFFF = -1)
+    wire kx_faixa = (kdx == -12'sd1) || (!kdx[11] && kdx <= $signed(braco_x));
+    wire ky_faixa = (kdy == -12'sd1) || (!kdy[11] && kdy <= $signed(braco_y));
+
+    wire canto_vert  = (modo == MODO_CANTO) && (kdx_abs <= 12'd1) && ky_faixa;
+    wire canto_horiz = (modo == MODO_CANTO) && (kdy_abs <= 12'd1) && kx_faixa;
+
+    // Como em desenhar_cantos_animados(): linha branca só a partir do vértice
+    wire       canto_hit = canto_vert || canto_horiz;
+    wire [7:0] canto_cor = canto_vert ? ((kdx == 12'sd0 && !kdy[11]) ? BRANCO : PRETO)
+                                      : ((kdy == 12'sd0 && !kdx[11]) ? BRANCO : PRETO);
+
+    // --- Composição: cursor > janela > framebuffer ---
+    assign pixel_out = cursor_hit ? cursor_cor :
+                       canto_hit  ? canto_cor  :
+                       ret_hit    ? BRANCO     :
+                                    pixel_base;
+
+endmodule
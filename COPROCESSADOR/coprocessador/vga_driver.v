@@ -11,7 +11,9 @@ module vga_driver (
     output [7:0] blue,    // BLUE (to resistor DAC to VGA connector)
     output sync,          // SYNC to VGA connector
     output clk,           // CLK to VGA connector
-    output blank          // BLANK to VGA connector
+    output blank,         // BLANK to VGA connector
+    output vblank,        // HIGH outside the active lines (vertical blanking)
+    output [30:0] frame_count // Frames completed, increments at start of vblank
 );
 
     // Horizontal parameters (measured in clock cycles)
@@ -55,6 +57,8 @@ module vga_driver (
 
     reg     [7:0]    h_state ;
     reg     [7:0]    v_state ;
+
+    reg     [30:0]  frame_counter = 31'd_0 ;
 			
 	 reg [7:0] gray_value;
 	 
@@ -70,6 +74,8 @@ module vga_driver (
             v_state     <= V_ACTIVE_STATE  ;
             // Deassert line done
             line_done   <= LOW ;
+            // Zero the frame counter
+            frame_counter <= 31'd_0 ;
         end
         else begin
             //////////////////////////////////////////////////////////////////////////
@@ -121,6 +127,8 @@ module vga_driver (
                 vsync_reg <= HIGH ;
                 // state transition - only on end of lines
                 v_state<=(line_done==HIGH)?((v_counter==V_ACTIVE)?V_FRONT_STATE:V_ACTIVE_STATE):V_ACTIVE_STATE ;
+                // count the frame when the last active line ends
+                frame_counter<=(line_done==HIGH && v_counter==V_ACTIVE)?(frame_counter + 31'd_1):frame_counter ;
             end
             if (v_state == V_FRONT_STATE) begin
                 // increment vertical counter at end of line, zero on state transition
@@ -174,6 +182,8 @@ module vga_driver (
     assign clk = clock ;
     assign sync = 1'b_0 ;
     assign blank = hysnc_reg & vsync_reg ;
+    assign vblank = (v_state != V_ACTIVE_STATE) ;
+    assign frame_count = frame_counter ;
     // The x/y coordinates that should be available on the NEXT cycle
     assign next_x = (h_state==H_ACTIVE_STATE)?h_counter:10'd_0 ;
     assign next_y = (v_state==V_ACTIVE_STATE)?v_counter:10'd_0 ;
@@ -306,7 +306,12 @@ assign stm_hw_events    = {{3{1'b0}},SW, fpga_led_internal, fpga_debounced_butto
 		
 		//wire reset_alu = LEDR[9];
 		wire [31:0] status_data_out;
+		wire [31:0] limpeza_data_out;
+		wire [19:0] area_ini, area_fim;
 		wire [9:0] saida_pio;
+		wire [31:0] passo_x, passo_y;
+		wire [31:0] roi;
+		wire        rom_leitura;
 		
     alu_algoritmos alu (
         .clk(clk25),
@@ -314,6 +319,9 @@ assign stm_hw_events    = {{3{1'b0}},SW, fpga_led_internal, fpga_debounced_butto
         .control_data_in(saida_pio),
 		  
 		  .start_in(1),
+        .passo_x_in(passo_x),
+        .passo_y_in(passo_y),
+        .roi_in(roi),
         // Interface com a ROM
         .rom_data_in(rom_data),
         .rom_addr_out(rom_addr),
@@ -324,17 +332,59 @@ assign stm_hw_events    = {{3{1'b0}},SW, fpga_led_internal, fpga_debounced_butto
         .ram_wren_out(ram_wren),
 
         // Status
-        .status_data_out(status_data_out)
+        .status_data_out(status_data_out),
+        .limpeza_data_out(limpeza_data_out),
+        .rom_leitura_out(rom_leitura),
+        .area_ini_out(area_ini),
+        .area_fim_out(area_fim)
+    );
+
+    // --- Contadores de desempenho: lidos pelo HPS via pio_contador_sel/pio_contador ---
+    wire [2:0]  contador_sel;
+    wire [31:0] contador_valor;
+
+    contadores_alu contadores_inst (
+        .clk(clk25),
+        .reset(~hps_fpga_reset_n),
+        .start(reset_alu_hps),
+        .done(status_data_out[0]),
+        .rom_leitura(rom_leitura),
+        .ram_wren(ram_wren),
+        .ciclos(status_data_out[31:2]),
+        .ciclos_limpeza(limpeza_data_out[29:0]),
+        .sel(contador_sel),
+        .valor(contador_valor)
     );
 
     // --- Driver VGA: lê da RAM e gera sinais (sem alterações) ---
     wire [9:0] next_x, next_y;
     assign vga_addr = (next_y * 10'd640 + next_x);
+
+    // Status do VGA para o HPS (pio_vga): {quadros[30:0], vblank}
+    wire        vga_vblank;
+    wire [30:0] vga_quadro;
+
+    // --- Overlay: cursor e janela de seleção desenhados sobre o framebuffer ---
+    wire [31:0] cursor_cfg, janela_ini, janela_fim;
+    wire [7:0]  pixel_overlay;
+
+    overlay_vga overlay_inst (
+        .clk(clk25),
+        .next_x(next_x),
+        .next_y(next_y),
+        .pixel_in(ram_q),
+        .area_ini(area_ini),
+        .area_fim(area_fim),
+        .cursor_cfg(cursor_cfg),
+        .janela_ini(janela_ini),
+        .janela_fim(janela_fim),
+        .pixel_out(pixel_overlay)
+    );
     
     vga_driver vga_inst (
         .clock(clk25),
         .reset(1'b1),
-        .color_in(ram_q),   // pixel vindo da RAM
+        .color_in(pixel_overlay), // pixel da RAM com o overlay
         .next_x(next_x),    // coordenada X
         .next_y(next_y),    // coordenada Y
         .hsync(VGA_HS),
@@ -344,7 +394,9 @@ assign stm_hw_events    = {{3{1'b0}},SW, fpga_led_internal, fpga_debounced_butto
         .blue(VGA_B),
         .sync(VGA_SYNC_N),
         .clk(VGA_CLK),
-        .blank(VGA_BLANK_N)
+        .blank(VGA_BLANK_N),
+        .vblank(vga_vblank),
+        .frame_count(vga_quadro)
     );
 	 
 //////////////////////////////
@@ -353,12 +405,34 @@ assign stm_hw_events    = {{3{1'b0}},SW, fpga_led_internal, fpga_debounced_butto
 
 wire reset_alu_hps;
 
+    // --- Bancos da imagem fonte (ping-pong) ---
+    // onchip_memory2_1 guarda duas imagens 160x120: banco 0 em 0, banco 1 em 19200.
+    // saida_pio[7] escolhe o banco e é capturado durante o pulso de start, então
+    // o HPS pode carregar o outro banco enquanto a ALU processa este
+    reg banco_alu;
+    always @(posedge clk25) begin
+        if (reset_alu_hps)
+            banco_alu <= saida_pio[7];
+    end
+    wire [15:0] rom_addr_banco = banco_alu ? ({1'b0, rom_addr} + 16'd19200) : {1'b0, rom_addr};
+
 soc_system u0 (
 
     .pio_10bits_external_connection_export (saida_pio),  // pio_10bits_external_connection.export
 	 .pio_reset_alu_external_connection_export (reset_alu_hps),  // pio_reset_alu_external_connection.export
+	 .pio_status_external_connection_export (status_data_out),   // pio_status_external_connection.export
+	 .pio_vga_external_connection_export ({vga_quadro, vga_vblank}), // pio_vga_external_connection.export
+	 .pio_cursor_external_connection_export (cursor_cfg),         // pio_cursor_external_connection.export
+	 .pio_janela_ini_external_connection_export (janela_ini),     // pio_janela_ini_external_connection.export
+	 .pio_janela_fim_external_connection_export (janela_fim),     // pio_janela_fim_external_connection.export
+	 .pio_limpeza_external_connection_export (limpeza_data_out),  // pio_limpeza_external_connection.export
+	 .pio_passo_x_external_connection_export (passo_x),           // pio_passo_x_external_connection.export
+	 .pio_passo_y_external_connection_export (passo_y),           // pio_passo_y_external_connection.export
+	 .pio_roi_external_connection_export (roi),                   // pio_roi_external_connection.export
+	 .pio_contador_sel_external_connection_export (contador_sel), // pio_contador_sel_external_connection.export
+	 .pio_contador_external_connection_export (contador_valor),   // pio_contador_external_connection.export
 	 
-	 .onchip_memory2_1_s2_address   (rom_addr),       // ENTRADA: Vem do cálculo
+	 .onchip_memory2_1_s2_address   (rom_addr_banco), // ENTRADA: Vem do cálculo + banco
     .onchip_memory2_1_s2_chipselect(1'b1),           // ENTRADA: Sempre selecionado
     .onchip_memory2_1_s2_clken     (1'b1),           // ENTRADA: Sempre habilitado
     .onchip_memory2_1_s2_write     (1'b0),           // ENTRADA: alu só lê
@@ -61,8 +61,8 @@
 #define ONCHIP_MEMORY2_1_COMPONENT_TYPE altera_avalon_onchip_memory2
 #define ONCHIP_MEMORY2_1_COMPONENT_NAME onchip_memory2_1
 #define ONCHIP_MEMORY2_1_BASE 0x0
-#define ONCHIP_MEMORY2_1_SPAN 19200
-#define ONCHIP_MEMORY2_1_END 0x4aff
+#define ONCHIP_MEMORY2_1_SPAN 38400
+#define ONCHIP_MEMORY2_1_END 0x95ff
 #define ONCHIP_MEMORY2_1_ALLOW_IN_SYSTEM_MEMORY_CONTENT_EDITOR 0
 #define ONCHIP_MEMORY2_1_ALLOW_MRAM_SIM_CONTENTS_ONLY_FILE 0
 #define ONCHIP_MEMORY2_1_CONTENTS_INFO ""
@@ -76,7 +76,7 @@
 #define ONCHIP_MEMORY2_1_READ_DURING_WRITE_MODE DONT_CARE
 #define ONCHIP_MEMORY2_1_SINGLE_CLOCK_OP 0
 #define ONCHIP_MEMORY2_1_SIZE_MULTIPLE 1
-#define ONCHIP_MEMORY2_1_SIZE_VALUE 19200
+#define ONCHIP_MEMORY2_1_SIZE_VALUE 38400
 #define ONCHIP_MEMORY2_1_WRITABLE 1
 #define ONCHIP_MEMORY2_1_MEMORY_INFO_DAT_SYM_INSTALL_DIR SIM_DIR
 #define ONCHIP_MEMORY2_1_MEMORY_INFO_GENERATE_DAT_SYM 1
@@ -93,9 +93,9 @@
  */
 #define PIO_RESET_ALU_COMPONENT_TYPE altera_avalon_pio
 #define PIO_RESET_ALU_COMPONENT_NAME pio_reset_alu
-#define PIO_RESET_ALU_BASE 0x8000
+#define PIO_RESET_ALU_BASE 0x18000
 #define PIO_RESET_ALU_SPAN 16
-#define PIO_RESET_ALU_END 0x800f
+#define PIO_RESET_ALU_END 0x1800f
 #define PIO_RESET_ALU_BIT_CLEARING_EDGE_REGISTER 0
 #define PIO_RESET_ALU_BIT_MODIFYING_OUTPUT_REGISTER 0
 #define PIO_RESET_ALU_CAPTURE 0
@@ -117,9 +117,9 @@
  */
 #define PIO_10BITS_COMPONENT_TYPE altera_avalon_pio
 #define PIO_10BITS_COMPONENT_NAME pio_10bits
-#define PIO_10BITS_BASE 0x8010
+#define PIO_10BITS_BASE 0x18010
 #define PIO_10BITS_SPAN 16
-#define PIO_10BITS_END 0x801f
+#define PIO_10BITS_END 0x1801f
 #define PIO_10BITS_BIT_CLEARING_EDGE_REGISTER 0
 #define PIO_10BITS_BIT_MODIFYING_OUTPUT_REGISTER 0
 #define PIO_10BITS_CAPTURE 0
@@ -134,6 +134,270 @@
 #define PIO_10BITS_IRQ_TYPE NONE
 #define PIO_10BITS_RESET_VALUE 1023
 
+/*
+ * Macros for device 'pio_status', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_STATUS_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_STATUS_COMPONENT_TYPE altera_avalon_pio
+#define PIO_STATUS_COMPONENT_NAME pio_status
+#define PIO_STATUS_BASE 0x18020
+#define PIO_STATUS_SPAN 16
+#define PIO_STATUS_END 0x1802f
+#define PIO_STATUS_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_STATUS_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_STATUS_CAPTURE 0
+#define PIO_STATUS_DATA_WIDTH 32
+#define PIO_STATUS_DO_TEST_BENCH_WIRING 0
+#define PIO_STATUS_DRIVEN_SIM_VALUE 0
+#define PIO_STATUS_EDGE_TYPE NONE
+#define PIO_STATUS_FREQ 50000000
+#define PIO_STATUS_HAS_IN 1
+#define PIO_STATUS_HAS_OUT 0
+#define PIO_STATUS_HAS_TRI 0
+#define PIO_STATUS_IRQ_TYPE NONE
+#define PIO_STATUS_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_vga', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_VGA_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_VGA_COMPONENT_TYPE altera_avalon_pio
+#define PIO_VGA_COMPONENT_NAME pio_vga
+#define PIO_VGA_BASE 0x18030
+#define PIO_VGA_SPAN 16
+#define PIO_VGA_END 0x1803f
+#define PIO_VGA_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_VGA_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_VGA_CAPTURE 0
+#define PIO_VGA_DATA_WIDTH 32
+#define PIO_VGA_DO_TEST_BENCH_WIRING 0
+#define PIO_VGA_DRIVEN_SIM_VALUE 0
+#define PIO_VGA_EDGE_TYPE NONE
+#define PIO_VGA_FREQ 50000000
+#define PIO_VGA_HAS_IN 1
+#define PIO_VGA_HAS_OUT 0
+#define PIO_VGA_HAS_TRI 0
+#define PIO_VGA_IRQ_TYPE NONE
+#define PIO_VGA_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_cursor', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_CURSOR_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_CURSOR_COMPONENT_TYPE altera_avalon_pio
+#define PIO_CURSOR_COMPONENT_NAME pio_cursor
+#define PIO_CURSOR_BASE 0x18040
+#define PIO_CURSOR_SPAN 16
+#define PIO_CURSOR_END 0x1804f
+#define PIO_CURSOR_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_CURSOR_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_CURSOR_CAPTURE 0
+#define PIO_CURSOR_DATA_WIDTH 32
+#define PIO_CURSOR_DO_TEST_BENCH_WIRING 0
+#define PIO_CURSOR_DRIVEN_SIM_VALUE 0
+#define PIO_CURSOR_EDGE_TYPE NONE
+#define PIO_CURSOR_FREQ 50000000
+#define PIO_CURSOR_HAS_IN 0
+#define PIO_CURSOR_HAS_OUT 1
+#define PIO_CURSOR_HAS_TRI 0
+#define PIO_CURSOR_IRQ_TYPE NONE
+#define PIO_CURSOR_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_janela_ini', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_JANELA_INI_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_JANELA_INI_COMPONENT_TYPE altera_avalon_pio
+#define PIO_JANELA_INI_COMPONENT_NAME pio_janela_ini
+#define PIO_JANELA_INI_BASE 0x18050
+#define PIO_JANELA_INI_SPAN 16
+#define PIO_JANELA_INI_END 0x1805f
+#define PIO_JANELA_INI_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_JANELA_INI_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_JANELA_INI_CAPTURE 0
+#define PIO_JANELA_INI_DATA_WIDTH 32
+#define PIO_JANELA_INI_DO_TEST_BENCH_WIRING 0
+#define PIO_JANELA_INI_DRIVEN_SIM_VALUE 0
+#define PIO_JANELA_INI_EDGE_TYPE NONE
+#define PIO_JANELA_INI_FREQ 50000000
+#define PIO_JANELA_INI_HAS_IN 0
+#define PIO_JANELA_INI_HAS_OUT 1
+#define PIO_JANELA_INI_HAS_TRI 0
+#define PIO_JANELA_INI_IRQ_TYPE NONE
+#define PIO_JANELA_INI_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_janela_fim', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_JANELA_FIM_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_JANELA_FIM_COMPONENT_TYPE altera_avalon_pio
+#define PIO_JANELA_FIM_COMPONENT_NAME pio_janela_fim
+#define PIO_JANELA_FIM_BASE 0x18060
+#define PIO_JANELA_FIM_SPAN 16
+#define PIO_JANELA_FIM_END 0x1806f
+#define PIO_JANELA_FIM_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_JANELA_FIM_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_JANELA_FIM_CAPTURE 0
+#define PIO_JANELA_FIM_DATA_WIDTH 32
+#define PIO_JANELA_FIM_DO_TEST_BENCH_WIRING 0
+#define PIO_JANELA_FIM_DRIVEN_SIM_VALUE 0
+#define PIO_JANELA_FIM_EDGE_TYPE NONE
+#define PIO_JANELA_FIM_FREQ 50000000
+#define PIO_JANELA_FIM_HAS_IN 0
+#define PIO_JANELA_FIM_HAS_OUT 1
+#define PIO_JANELA_FIM_HAS_TRI 0
+#define PIO_JANELA_FIM_IRQ_TYPE NONE
+#define PIO_JANELA_FIM_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_limpeza', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_LIMPEZA_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_LIMPEZA_COMPONENT_TYPE altera_avalon_pio
+#define PIO_LIMPEZA_COMPONENT_NAME pio_limpeza
+#define PIO_LIMPEZA_BASE 0x18070
+#define PIO_LIMPEZA_SPAN 16
+#define PIO_LIMPEZA_END 0x1807f
+#define PIO_LIMPEZA_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_LIMPEZA_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_LIMPEZA_CAPTURE 0
+#define PIO_LIMPEZA_DATA_WIDTH 32
+#define PIO_LIMPEZA_DO_TEST_BENCH_WIRING 0
+#define PIO_LIMPEZA_DRIVEN_SIM_VALUE 0
+#define PIO_LIMPEZA_EDGE_TYPE NONE
+#define PIO_LIMPEZA_FREQ 50000000
+#define PIO_LIMPEZA_HAS_IN 1
+#define PIO_LIMPEZA_HAS_OUT 0
+#define PIO_LIMPEZA_HAS_TRI 0
+#define PIO_LIMPEZA_IRQ_TYPE NONE
+#define PIO_LIMPEZA_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_passo_x', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_PASSO_X_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_PASSO_X_COMPONENT_TYPE altera_avalon_pio
+#define PIO_PASSO_X_COMPONENT_NAME pio_passo_x
+#define PIO_PASSO_X_BASE 0x18080
+#define PIO_PASSO_X_SPAN 16
+#define PIO_PASSO_X_END 0x1808f
+#define PIO_PASSO_X_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_PASSO_X_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_PASSO_X_CAPTURE 0
+#define PIO_PASSO_X_DATA_WIDTH 32
+#define PIO_PASSO_X_DO_TEST_BENCH_WIRING 0
+#define PIO_PASSO_X_DRIVEN_SIM_VALUE 0
+#define PIO_PASSO_X_EDGE_TYPE NONE
+#define PIO_PASSO_X_FREQ 50000000
+#define PIO_PASSO_X_HAS_IN 0
+#define PIO_PASSO_X_HAS_OUT 1
+#define PIO_PASSO_X_HAS_TRI 0
+#define PIO_PASSO_X_IRQ_TYPE NONE
+#define PIO_PASSO_X_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_passo_y', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_PASSO_Y_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_PASSO_Y_COMPONENT_TYPE altera_avalon_pio
+#define PIO_PASSO_Y_COMPONENT_NAME pio_passo_y
+#define PIO_PASSO_Y_BASE 0x18090
+#define PIO_PASSO_Y_SPAN 16
+#define PIO_PASSO_Y_END 0x1809f
+#define PIO_PASSO_Y_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_PASSO_Y_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_PASSO_Y_CAPTURE 0
+#define PIO_PASSO_Y_DATA_WIDTH 32
+#define PIO_PASSO_Y_DO_TEST_BENCH_WIRING 0
+#define PIO_PASSO_Y_DRIVEN_SIM_VALUE 0
+#define PIO_PASSO_Y_EDGE_TYPE NONE
+#define PIO_PASSO_Y_FREQ 50000000
+#define PIO_PASSO_Y_HAS_IN 0
+#define PIO_PASSO_Y_HAS_OUT 1
+#define PIO_PASSO_Y_HAS_TRI 0
+#define PIO_PASSO_Y_IRQ_TYPE NONE
+#define PIO_PASSO_Y_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_roi', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_ROI_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_ROI_COMPONENT_TYPE altera_avalon_pio
+#define PIO_ROI_COMPONENT_NAME pio_roi
+#define PIO_ROI_BASE 0x180a0
+#define PIO_ROI_SPAN 16
+#define PIO_ROI_END 0x180af
+#define PIO_ROI_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_ROI_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_ROI_CAPTURE 0
+#define PIO_ROI_DATA_WIDTH 32
+#define PIO_ROI_DO_TEST_BENCH_WIRING 0
+#define PIO_ROI_DRIVEN_SIM_VALUE 0
+#define PIO_ROI_EDGE_TYPE NONE
+#define PIO_ROI_FREQ 50000000
+#define PIO_ROI_HAS_IN 0
+#define PIO_ROI_HAS_OUT 1
+#define PIO_ROI_HAS_TRI 0
+#define PIO_ROI_IRQ_TYPE NONE
+#define PIO_ROI_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_contador_sel', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_CONTADOR_SEL_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_CONTADOR_SEL_COMPONENT_TYPE altera_avalon_pio
+#define PIO_CONTADOR_SEL_COMPONENT_NAME pio_contador_sel
+#define PIO_CONTADOR_SEL_BASE 0x180b0
+#define PIO_CONTADOR_SEL_SPAN 16
+#define PIO_CONTADOR_SEL_END 0x180bf
+#define PIO_CONTADOR_SEL_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_CONTADOR_SEL_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_CONTADOR_SEL_CAPTURE 0
+#define PIO_CONTADOR_SEL_DATA_WIDTH 3
+#define PIO_CONTADOR_SEL_DO_TEST_BENCH_WIRING 0
+#define PIO_CONTADOR_SEL_DRIVEN_SIM_VALUE 0
+#define PIO_CONTADOR_SEL_EDGE_TYPE NONE
+#define PIO_CONTADOR_SEL_FREQ 50000000
+#define PIO_CONTADOR_SEL_HAS_IN 0
+#define PIO_CONTADOR_SEL_HAS_OUT 1
+#define PIO_CONTADOR_SEL_HAS_TRI 0
+#define PIO_CONTADOR_SEL_IRQ_TYPE NONE
+#define PIO_CONTADOR_SEL_RESET_VALUE 0
+
+/*
+ * Macros for device 'pio_contador', class 'altera_avalon_pio'
+ * The macros are prefixed with 'PIO_CONTADOR_'.
+ * The prefix is the slave descriptor.
+ */
+#define PIO_CONTADOR_COMPONENT_TYPE altera_avalon_pio
+#define PIO_CONTADOR_COMPONENT_NAME pio_contador
+#define PIO_CONTADOR_BASE 0x180c0
+#define PIO_CONTADOR_SPAN 16
+#define PIO_CONTADOR_END 0x180cf
+#define PIO_CONTADOR_BIT_CLEARING_EDGE_REGISTER 0
+#define PIO_CONTADOR_BIT_MODIFYING_OUTPUT_REGISTER 0
+#define PIO_CONTADOR_CAPTURE 0
+#define PIO_CONTADOR_DATA_WIDTH 32
+#define PIO_CONTADOR_DO_TEST_BENCH_WIRING 0
+#define PIO_CONTADOR_DRIVEN_SIM_VALUE 0
+#define PIO_CONTADOR_EDGE_TYPE NONE
+#define PIO_CONTADOR_FREQ 50000000
+#define PIO_CONTADOR_HAS_IN 1
+#define PIO_CONTADOR_HAS_OUT 0
+#define PIO_CONTADOR_HAS_TRI 0
+#define PIO_CONTADOR_IRQ_TYPE NONE
+#define PIO_CONTADOR_RESET_VALUE 0
+
 /*
  * Macros for device 'sysid_qsys', class 'altera_avalon_sysid_qsys'
  * The macros are prefixed with 'SYSID_QSYS_'.
@@ -0,0 +1,38 @@
+// ========================================================================
+// blocoram_sim.v - Modelo comportamental do framebuffer 640x480
+//
+// Substitui blocoram.v (altsyncram) na simulação, com as mesmas portas e
+// a mesma temporização: escrita síncrona na porta A e leitura na porta B
+// com endereço e saída registrados (q chega 2 ciclos após rdaddress).
+// O conteúdo fica em 'memoria' para o testbench despejar.
+// ========================================================================
+
+module blocoram (
+    input  wire        clock,
+    input  wire [7:0]  data,
+    input  wire [18:0] rdaddress,
+    input  wire [18:0] wraddress,
+    input  wire        wren,
+    output reg  [7:0]  q
+);
+
+    localparam PALAVRAS = 640 * 480;
+
+    reg [7:0]  memoria [0:PALAVRAS-1];
+    reg [18:0] rdaddress_reg;
+
+    // power_up_uninitialized = "FALSE": o M10K liga zerado
+    integer i;
+    initial begin
+        for (i = 0; i < PALAVRAS; i = i + 1)
+            memoria[i] = 8'd0;
+    end
+
+    always @(posedge clock) begin
+        if (wren)
+            memoria[wraddress] <= data;
+        rdaddress_reg <= rdaddress;
+        q <= memoria[rdaddress_reg];
+    end
+
+endmodule
@@ -0,0 +1,31 @@
+// ========================================================================
+// memoria_imagem_sim.v - Modelo comportamental da porta s2 de
+// onchip_memory2_1 (imagem fonte 160x120)
+//
+// Endereço registrado e saída direta (slave2Latency = 1), no clock da
+// porta s2: CLOCK_50 (clk_0), o dobro do clk25 da ALU. O endereço que a
+// ALU registra numa borda de clk25 é amostrado meio ciclo depois, e o
+// dado está em rom_data_in na borda seguinte de clk25: um ciclo da ALU,
+// como ela espera. Com clk25 aqui o dado chegaria um ciclo mais tarde.
+// É a memória que substituiu ram1port na placa: ram1port registra
+// também a saída (dois ciclos) e não casa mais com a ALU.
+// Dois bancos, como na placa: banco 0 em 0 e banco 1 em 19200; o
+// testbench soma o deslocamento do banco como ghrd_top e carrega cada
+// banco com $readmemh.
+// ========================================================================
+
+module memoria_imagem_sim (
+    input  wire        clk,        // CLOCK_50
+    input  wire [15:0] address,    // rom_addr_banco
+    output reg  [7:0]  q
+);
+
+    localparam PALAVRAS = 2 * 160 * 120;
+
+    reg [7:0] memoria [0:PALAVRAS-1];
+
+    always @(posedge clk) begin
+        q <= memoria[address];
+    end
+
+endmodule
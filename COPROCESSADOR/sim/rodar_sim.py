@@ -0,0 +1,358 @@
+#!/usr/bin/env python3
+# ========================================================================
+# rodar_sim.py - Roda todos os opcodes da ALU em simulação
+#
+# Compila tb_alu.v com alu_algoritmos.v e contadores_alu.v (Icarus
+# Verilog ou Verilator), converte os BMPs de hps/auxiliares/test_images
+# para a memória de imagem e executa cada opcode sobre cada imagem.
+#
+# Para cada execução grava o framebuffer 640x480 em saida/<imagem>/ como
+# PGM e, ao fim, a tabela saida/ciclos.txt com os contadores e um CRC do
+# framebuffer. A tabela não tem caminhos nem datas: duas execuções antes e
+# depois de mudar a ALU podem ser comparadas com diff.
+#
+# Cada framebuffer também é comparado byte a byte com o de
+# alu_modelo_executar() (hps/alu_modelo.c, compilado com cc e carregado
+# por ctypes), e os contadores com alu_modelo_ciclos(),
+# alu_modelo_ciclos_limpeza() e alu_modelo_acessos() (a latência é ciclos
+# mais o pulso de start menos o sincronizador); uma diferença marca
+# a linha com DIVERGE e o script sai com 1.
+#
+# A imagem vai para o banco que o opcode escolhe (config[7]) e o outro
+# banco recebe o negativo dela: ler o banco errado diverge do modelo.
+#
+# Uso: python3 rodar_sim.py [--simulador iverilog|verilator]
+#                           [--imagens DIR] [--saida DIR] [--tabela ARQ]
+#                           [--opcodes A,B]
+# ========================================================================
+
+import argparse
+import ctypes
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import zlib
+
+DIR_SIM = os.path.dirname(os.path.abspath(__file__))
+DIR_RTL = os.path.join(DIR_SIM, '..', 'coprocessador')
+DIR_HPS = os.path.join(DIR_SIM, '..', '..', 'hps')
+DIR_IMAGENS = os.path.join(DIR_HPS, 'auxiliares', 'test_images')
+
+PULSO_START = 4     # ciclos com pio_reset_alu em 1, como em tb_alu.v
+
+FONTES = [
+    os.path.join(DIR_SIM, 'tb_alu.v'),
+    os.path.join(DIR_SIM, 'memoria_imagem_sim.v'),
+    os.path.join(DIR_SIM, 'blocoram_sim.v'),
+    os.path.join(DIR_RTL, 'clk_divider.v'),
+    os.path.join(DIR_RTL, 'alu_algoritmos.v'),
+    os.path.join(DIR_RTL, 'contadores_alu.v'),
+]
+
+IMG_LARGURA, IMG_ALTURA = 160, 120
+FB_LARGURA, FB_ALTURA = 640, 480
+
+
+def passo(zoom):
+    """PASSO_ESCALA de coprocessador.h: pixels da fonte por pixel da tela, 16.16"""
+    return int(65536.0 / zoom + 0.999999)
+
+
+def roi(x, y, largura, altura):
+    """Campo de pio_roi: {ativa[31], alt[30:24], larg[23:16], y0[14:8], x0[7:0]}"""
+    return (1 << 31) | (altura << 24) | (largura << 16) | (y << 8) | x
+
+
+# config[7]: banco 1 da imagem fonte (endereço 19200), como banco_alu em ghrd_top
+BANCO_1 = 1 << 7
+
+# (nome, config, passo_x, passo_y, roi), na ordem de bench_opcodes.c
+OPCODES = [
+    ('bypass', 0, 0x10000, 0x10000, 0),
+    ('media_0.5x', 11, 0x10000, 0x10000, 0),
+    ('media_0.25x', 12, 0x10000, 0x10000, 0),
+    ('vizinho_2x', 17, 0x10000, 0x10000, 0),
+    ('vizinho_4x', 18, 0x10000, 0x10000, 0),
+    ('vizinho_0.5x', 27, 0x10000, 0x10000, 0),
+    ('vizinho_0.25x', 28, 0x10000, 0x10000, 0),
+    ('replicacao_2x', 33, 0x10000, 0x10000, 0),
+    ('replicacao_4x', 34, 0x10000, 0x10000, 0),
+    ('bilinear_2x', 41, 0x10000, 0x10000, 0),
+    ('bilinear_4x', 42, 0x10000, 0x10000, 0),
+    ('escala_0.75x', 48, passo(0.75), passo(0.75), 0),
+    ('escala_1.5x', 48, passo(1.5), passo(1.5), 0),
+    ('escala_3x', 48, passo(3.0), passo(3.0), 0),
+    ('roi_40x30_4x', 18, 0x10000, 0x10000, roi(60, 45, 40, 30)),
+    ('bypass_banco1', BANCO_1 | 0, 0x10000, 0x10000, 0),
+    ('bilinear_2x_banco1', BANCO_1 | 41, 0x10000, 0x10000, 0),
+]
+
+CAMPOS = ['concluido', 'ciclos', 'limpeza', 'leituras_rom', 'escritas_fb', 'latencia']
+
+
+# ------------------------------------------------------------------------
+# Imagens
+# ------------------------------------------------------------------------
+
+def luma(b, g, r):
+    return (299 * r + 587 * g + 114 * b) // 1000
+
+
+def ler_bmp(caminho):
+    """Imagem 160x120 em tons de cinza, convertida como carregar_bitmap()
+    em bitmap.c: 8 bits pela paleta, 24 bits por (299R + 587G + 114B) // 1000"""
+    with open(caminho, 'rb') as f:
+        dados = f.read()
+
+    if dados[:2] != b'BM':
+        raise ValueError('%s: não é BMP' % caminho)
+    offset = struct.unpack_from('<I', dados, 10)[0]
+    largura, altura = struct.unpack_from('<ii', dados, 18)
+    bits = struct.unpack_from('<H', dados, 28)[0]
+    if largura != IMG_LARGURA or abs(altura) != IMG_ALTURA:
+        raise ValueError('%s: %dx%d, esperado 160x120' % (caminho, largura, abs(altura)))
+    if bits not in (8, 24):
+        raise ValueError('%s: %d bits por pixel não suportado' % (caminho, bits))
+
+    # Índice -> cinza; fora da paleta, preto; sem paleta, o próprio índice
+    paleta = list(range(256))
+    if bits == 8:
+        inicio = 14 + struct.unpack_from('<I', dados, 14)[0]
+        cores = struct.unpack_from('<I', dados, 46)[0] or 256
+        cores = max(0, min(cores, 256, (min(offset, len(dados)) - inicio) // 4))
+        if cores:
+            paleta = [luma(*dados[inicio + 4 * i: inicio + 4 * i + 3]) if i < cores else 0
+                      for i in range(256)]
+
+    bytes_pixel = bits // 8
+    stride = (largura * bytes_pixel + 3) & ~3
+    pixels = bytearray(IMG_LARGURA * IMG_ALTURA)
+
+    for y in range(IMG_ALTURA):
+        destino = (IMG_ALTURA - 1 - y) if altura > 0 else y
+        linha = dados[offset + y * stride: offset + y * stride + largura * bytes_pixel]
+        for x in range(IMG_LARGURA):
+            if bits == 8:
+                cinza = paleta[linha[x]]
+            else:
+                cinza = luma(*linha[3 * x: 3 * x + 3])
+            pixels[destino * IMG_LARGURA + x] = cinza
+    return pixels
+
+
+def escrever_hex(caminho, pixels):
+    with open(caminho, 'w') as f:
+        f.write('\n'.join('%02x' % p for p in pixels))
+        f.write('\n')
+
+
+def ler_hex(caminho, tamanho):
+    """Conteúdo de $writememh; posições x (nunca escritas) viram 0"""
+    pixels = bytearray(tamanho)
+    i = 0
+    with open(caminho) as f:
+        for linha in f:
+            linha = linha.strip()
+            if not linha or linha.startswith('//'):
+                continue
+            if linha.startswith('@'):
+                i = int(linha[1:], 16)
+                continue
+            pixels[i] = int(linha, 16) if re.fullmatch(r'[0-9a-fA-F]+', linha) else 0
+            i += 1
+    return pixels
+
+
+def escrever_pgm(caminho, pixels, largura, altura):
+    with open(caminho, 'wb') as f:
+        f.write(b'P5\n%d %d\n255\n' % (largura, altura))
+        f.write(bytes(pixels))
+
+
+# ------------------------------------------------------------------------
+# Simulador
+# ------------------------------------------------------------------------
+
+def compilar(simulador, dir_build):
+    os.makedirs(dir_build, exist_ok=True)
+
+    if simulador == 'iverilog':
+        executavel = os.path.join(dir_build, 'tb_alu.vvp')
+        comando = ['iverilog', '-g2012', '-s', 'tb_alu', '-o', executavel] + FONTES
+        subprocess.run(comando, check=True)
+        return ['vvp', '-n', executavel]
+
+    comando = ['verilator', '--binary', '--timing', '-Wno-fatal', '-O3',
+               '--top-module', 'tb_alu', '--Mdir', dir_build, '-o', 'tb_alu'] + FONTES
+    subprocess.run(comando, check=True)
+    return [os.path.join(dir_build, 'tb_alu')]
+
+
+def compilar_modelo(dir_build):
+    """alu_modelo.c como biblioteca compartilhada, para conferir os framebuffers"""
+    os.makedirs(dir_build, exist_ok=True)
+    biblioteca = os.path.join(dir_build, 'libalu_modelo.so')
+    compilador = os.environ.get('CC', 'cc')
+    subprocess.run([compilador, '-O2', '-shared', '-fPIC', '-o', biblioteca,
+                    os.path.join(DIR_HPS, 'alu_modelo.c')], check=True)
+
+    modelo = ctypes.CDLL(biblioteca)
+    modelo.alu_modelo_executar.argtypes = [
+        ctypes.c_int, ctypes.c_uint, ctypes.c_uint, ctypes.c_uint,
+        ctypes.c_char_p, ctypes.c_char_p]
+    modelo.alu_modelo_executar.restype = None
+    modelo.alu_modelo_ciclos.argtypes = [ctypes.c_int, ctypes.c_uint, ctypes.c_uint, ctypes.c_uint]
+    modelo.alu_modelo_ciclos.restype = ctypes.c_uint
+    modelo.alu_modelo_ciclos_limpeza.argtypes = [ctypes.c_int, ctypes.c_uint]
+    modelo.alu_modelo_ciclos_limpeza.restype = ctypes.c_uint
+    modelo.alu_modelo_acessos.argtypes = [
+        ctypes.c_int, ctypes.c_uint, ctypes.c_uint, ctypes.c_uint,
+        ctypes.POINTER(ctypes.c_uint), ctypes.POINTER(ctypes.c_uint)]
+    modelo.alu_modelo_acessos.restype = None
+    return modelo
+
+
+def framebuffer_modelo(modelo, pixels, config, passo_x, passo_y, valor_roi):
+    """Framebuffer de uma operação partindo de um blocoram zerado, como o
+    blocoram_sim.v no início de cada simulação"""
+    fb = ctypes.create_string_buffer(FB_LARGURA * FB_ALTURA)
+    modelo.alu_modelo_executar(config, passo_x, passo_y, valor_roi, bytes(pixels), fb)
+    return fb.raw
+
+
+def contadores_modelo(modelo, config, passo_x, passo_y, valor_roi):
+    """Contadores 0 a 4 de contadores_alu.v segundo alu_modelo.c"""
+    leituras, escritas = ctypes.c_uint(), ctypes.c_uint()
+    modelo.alu_modelo_acessos(config, passo_x, passo_y, valor_roi,
+                              ctypes.byref(leituras), ctypes.byref(escritas))
+    ciclos = modelo.alu_modelo_ciclos(config, passo_x, passo_y, valor_roi)
+    return {
+        'ciclos': ciclos,
+        'limpeza': modelo.alu_modelo_ciclos_limpeza(config, valor_roi),
+        'leituras_rom': leituras.value,
+        'escritas_fb': escritas.value,
+        # Pulso de tb_alu.v menos os 3 flip-flops do sincronizador de start
+        'latencia': ciclos + PULSO_START - 3,
+    }
+
+
+def diferencas(fb, referencia):
+    """Quantidade de bytes diferentes e a posição (x, y) do primeiro"""
+    total, primeiro = 0, None
+    for i, (a, b) in enumerate(zip(fb, referencia)):
+        if a != b:
+            total += 1
+            if primeiro is None:
+                primeiro = (i % FB_LARGURA, i // FB_LARGURA)
+    return total, primeiro
+
+
+def executar(comando_sim, arquivo_imagem, arquivo_outro, arquivo_fb,
+             config, passo_x, passo_y, valor_roi):
+    argumentos = comando_sim + [
+        '+imagem=%s' % arquivo_imagem,
+        '+outro=%s' % arquivo_outro,
+        '+fb=%s' % arquivo_fb,
+        '+config=%d' % config,
+        '+passo_x=%x' % passo_x,
+        '+passo_y=%x' % passo_y,
+        '+roi=%x' % valor_roi,
+    ]
+    saida = subprocess.run(argumentos, check=True, capture_output=True, text=True).stdout
+
+    m = re.search(r'^RESULTADO (.*)$', saida, re.M)
+    if not m:
+        raise RuntimeError('tb_alu não imprimiu RESULTADO:\n' + saida)
+    resultado = dict(campo.split('=') for campo in m.group(1).split())
+    return {campo: int(resultado[campo]) for campo in CAMPOS}
+
+
+# ------------------------------------------------------------------------
+# Principal
+# ------------------------------------------------------------------------
+
+def main():
+    parser = argparse.ArgumentParser(description='Roda os opcodes da ALU em simulação')
+    parser.add_argument('--simulador', choices=['iverilog', 'verilator'], default='iverilog')
+    parser.add_argument('--imagens', default=DIR_IMAGENS)
+    parser.add_argument('--saida', default=os.path.join(DIR_SIM, 'saida'))
+    parser.add_argument('--tabela')
+    parser.add_argument('--opcodes', help='nomes separados por vírgula (padrão: todos)')
+    args = parser.parse_args()
+    if not args.tabela:
+        args.tabela = os.path.join(args.saida, 'ciclos.txt')
+
+    programa = 'iverilog' if args.simulador == 'iverilog' else 'verilator'
+    if not shutil.which(programa):
+        sys.exit('ERRO: %s não encontrado no PATH' % programa)
+
+    opcodes = OPCODES
+    if args.opcodes:
+        nomes = args.opcodes.split(',')
+        opcodes = [op for op in OPCODES if op[0] in nomes]
+
+    imagens = sorted(f for f in os.listdir(args.imagens) if f.lower().endswith('.bmp'))
+    if not imagens:
+        sys.exit('ERRO: nenhum BMP em %s' % args.imagens)
+
+    comando_sim = compilar(args.simulador, os.path.join(args.saida, 'build'))
+    modelo = compilar_modelo(os.path.join(args.saida, 'build'))
+
+    linhas = []
+    falhas = 0
+    for nome_imagem in imagens:
+        base = os.path.splitext(nome_imagem)[0]
+        dir_imagem = os.path.join(args.saida, base)
+        os.makedirs(dir_imagem, exist_ok=True)
+
+        arquivo_imagem = os.path.join(dir_imagem, 'imagem.hex')
+        arquivo_outro = os.path.join(dir_imagem, 'negativo.hex')
+        pixels = ler_bmp(os.path.join(args.imagens, nome_imagem))
+        escrever_hex(arquivo_imagem, pixels)
+        escrever_hex(arquivo_outro, bytes(255 - p for p in pixels))
+
+        for nome, config, passo_x, passo_y, valor_roi in opcodes:
+            arquivo_fb = os.path.join(dir_imagem, nome + '.hex')
+            r = executar(comando_sim, arquivo_imagem, arquivo_outro, arquivo_fb,
+                         config, passo_x, passo_y, valor_roi)
+
+            fb = ler_hex(arquivo_fb, FB_LARGURA * FB_ALTURA)
+            escrever_pgm(os.path.join(dir_imagem, nome + '.pgm'), fb, FB_LARGURA, FB_ALTURA)
+            os.remove(arquivo_fb)
+
+            referencia = framebuffer_modelo(modelo, pixels, config, passo_x, passo_y, valor_roi)
+            total, primeiro = diferencas(fb, referencia)
+            esperado = contadores_modelo(modelo, config, passo_x, passo_y, valor_roi)
+            divergencias = ['%s %d, modelo %d' % (campo, r[campo], valor)
+                            for campo, valor in esperado.items() if r[campo] != valor]
+            if total:
+                divergencias.insert(0, '%d bytes, primeiro em %d,%d' % ((total,) + primeiro))
+            if not r['concluido'] or divergencias:
+                falhas += 1
+            linhas.append('%-24s %-18s %6d %10s %8d %8d %8d %10d %08x%s' % (
+                base, nome, config,
+                r['ciclos'] if r['concluido'] else 'timeout',
+                r['limpeza'], r['leituras_rom'], r['escritas_fb'], r['latencia'],
+                zlib.crc32(bytes(fb)),
+                '  DIVERGE ' + '; '.join(divergencias) if divergencias else ''))
+            print(linhas[-1], flush=True)
+
+    cabecalho = '%-24s %-18s %6s %10s %8s %8s %8s %10s %8s' % (
+        'imagem', 'operacao', 'opcode', 'ciclos', 'limpeza', 'rom', 'fb', 'latencia', 'crc_fb')
+    with open(args.tabela, 'w') as f:
+        f.write(cabecalho + '\n')
+        f.write('\n'.join(linhas) + '\n')
+
+    print('\nTabela em %s' % args.tabela)
+    if falhas:
+        print('%d execuções com timeout ou diferentes de alu_modelo.c' % falhas)
+        return 1
+    print('Todos os framebuffers e contadores iguais aos de alu_modelo.c')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
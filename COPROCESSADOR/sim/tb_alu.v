@@ -0,0 +1,178 @@
+// ========================================================================
+// tb_alu.v - Testbench de uma operação da ALU (Icarus Verilog/Verilator)
+//
+// Liga alu_algoritmos e contadores_alu como em ghrd_top, com modelos
+// comportamentais da memória de imagem e do framebuffer, dispara um
+// opcode e espera o done. Os clocks seguem a placa: CLOCK_50 na memória
+// de imagem e clk25 (clk_divider) no resto. Parâmetros por plusargs:
+//
+//   +imagem=<arq>   imagem 160x120 em hex ($readmemh), obrigatório;
+//                   vai para o banco escolhido por config[7]
+//   +outro=<arq>    imagem do outro banco (padrão: não carregado)
+//   +config=<n>     valor de pio_10bits (opcode e banco), decimal
+//   +passo_x=<h>    pio_passo_x em hex (padrão 10000 = 1x)
+//   +passo_y=<h>    pio_passo_y em hex
+//   +roi=<h>        pio_roi em hex (padrão 0 = imagem inteira)
+//   +fb=<arq>       destino do framebuffer 640x480 ($writememh)
+//   +timeout=<n>    ciclos de clk25 até desistir (padrão 2000000)
+//
+// Imprime uma linha RESULTADO com o banco de contadores; rodar_sim.py
+// monta a tabela a partir dela.
+// ========================================================================
+
+`timescale 1ns / 1ps
+
+module tb_alu;
+
+    localparam PERIODO_50  = 20;        // CLOCK_50
+    localparam PULSO_START = 4;         // ciclos com pio_reset_alu em 1
+
+    // clk25 sai do mesmo divisor de ghrd_top; a memória de imagem fica em
+    // CLOCK_50, como onchip_memory2_1.clk2 (clk_0) no soc_system.qsys
+    reg clk50 = 1'b0;
+    always #(PERIODO_50 / 2) clk50 = ~clk50;
+
+    wire clk;
+    clk_divider divisor (
+        .clk_in(clk50),
+        .clk_out(clk)
+    );
+
+    // --- Registradores do HPS ---
+    reg        reset_sistema = 1'b1;
+    reg        reset_alu     = 1'b0;
+    reg [9:0]  config_alu    = 10'd0;
+    reg [31:0] passo_x       = 32'h10000;
+    reg [31:0] passo_y       = 32'h10000;
+    reg [31:0] roi           = 32'd0;
+    reg [2:0]  contador_sel  = 3'd0;
+
+    wire [14:0] rom_addr;
+    wire [15:0] rom_addr_banco;
+    wire [7:0]  rom_data;
+    wire [7:0]  ram_data;
+    wire [18:0] ram_addr;
+    wire        ram_wren;
+    wire [31:0] status_data, limpeza_data, contador_valor;
+    wire        rom_leitura;
+    wire [19:0] area_ini, area_fim;
+
+    // Banco da imagem fonte, como em ghrd_top: config[7] capturado durante
+    // o pulso de start escolhe o banco 0 (em 0) ou 1 (em 19200)
+    reg banco_alu;
+    always @(posedge clk) begin
+        if (reset_alu)
+            banco_alu <= config_alu[7];
+    end
+    assign rom_addr_banco = banco_alu ? ({1'b0, rom_addr} + 16'd19200) : {1'b0, rom_addr};
+
+    memoria_imagem_sim rom_inst (
+        .clk(clk50),
+        .address(rom_addr_banco),
+        .q(rom_data)
+    );
+
+    blocoram ram_inst (
+        .clock(clk),
+        .data(ram_data),
+        .rdaddress(19'd0),
+        .wraddress(ram_addr),
+        .wren(ram_wren),
+        .q()
+    );
+
+    alu_algoritmos alu (
+        .clk(clk),
+        .reset(reset_alu),
+        .control_data_in(config_alu),
+        .start_in(1'b1),
+        .passo_x_in(passo_x),
+        .passo_y_in(passo_y),
+        .roi_in(roi),
+        .rom_data_in(rom_data),
+        .rom_addr_out(rom_addr),
+        .ram_data_out(ram_data),
+        .ram_addr_out(ram_addr),
+        .ram_wren_out(ram_wren),
+        .status_data_out(status_data),
+        .limpeza_data_out(limpeza_data),
+        .rom_leitura_out(rom_leitura),
+        .area_ini_out(area_ini),
+        .area_fim_out(area_fim)
+    );
+
+    contadores_alu contadores_inst (
+        .clk(clk),
+        .reset(reset_sistema),
+        .start(reset_alu),
+        .done(status_data[0]),
+        .rom_leitura(rom_leitura),
+        .ram_wren(ram_wren),
+        .ciclos(status_data[31:2]),
+        .ciclos_limpeza(limpeza_data[29:0]),
+        .sel(contador_sel),
+        .valor(contador_valor)
+    );
+
+    reg [1023:0] arquivo_imagem, arquivo_outro, arquivo_fb;
+    integer      timeout, espera, i, banco_base;
+    reg [31:0]   contadores [0:6];
+
+    initial begin
+        if (!$value$plusargs("imagem=%s", arquivo_imagem)) begin
+            $display("ERRO: informe +imagem=<arquivo hex>");
+            $finish;
+        end
+        if (!$value$plusargs("config=%d", config_alu))
+            config_alu = 10'd0;
+        if (!$value$plusargs("passo_x=%h", passo_x))
+            passo_x = 32'h10000;
+        if (!$value$plusargs("passo_y=%h", passo_y))
+            passo_y = 32'h10000;
+        if (!$value$plusargs("roi=%h", roi))
+            roi = 32'd0;
+        if (!$value$plusargs("timeout=%d", timeout))
+            timeout = 2000000;
+
+        banco_base = config_alu[7] ? 19200 : 0;
+        $readmemh(arquivo_imagem, rom_inst.memoria, banco_base, banco_base + 19199);
+        if ($value$plusargs("outro=%s", arquivo_outro))
+            $readmemh(arquivo_outro, rom_inst.memoria, 19200 - banco_base, 38399 - banco_base);
+
+        repeat (2) @(posedge clk);
+        reset_sistema = 1'b0;
+
+        // Pulso de start, como enviar_start() no HPS
+        @(negedge clk);
+        reset_alu = 1'b1;
+        repeat (PULSO_START) @(negedge clk);
+        reset_alu = 1'b0;
+
+        espera = 0;
+        while (!status_data[0] && espera < timeout) begin
+            @(posedge clk);
+            espera = espera + 1;
+        end
+
+        // Deixa a última escrita e a borda do done chegarem aos contadores
+        repeat (4) @(posedge clk);
+
+        for (i = 0; i < 7; i = i + 1) begin
+            @(negedge clk);
+            contador_sel = i;
+            repeat (2) @(posedge clk);
+            #1 contadores[i] = contador_valor;
+        end
+
+        $display("RESULTADO concluido=%0d ciclos=%0d limpeza=%0d leituras_rom=%0d escritas_fb=%0d latencia=%0d area=%0d,%0d-%0d,%0d",
+                 status_data[0], contadores[0], contadores[1], contadores[2],
+                 contadores[3], contadores[4],
+                 area_ini[9:0], area_ini[18:10], area_fim[9:0], area_fim[18:10]);
+
+        if ($value$plusargs("fb=%s", arquivo_fb))
+            $writememh(arquivo_fb, ram_inst.memoria);
+
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,43 @@
+// ========================================================================
+// alocacoes.c - Contador de alocações dinâmicas (ver alocacoes.h)
+// ========================================================================
+
+#include "alocacoes.h"
+#include <stddef.h>
+
+static unsigned long total_alocacoes = 0;
+
+// Implementações originais da libc, resolvidas pelo ligador (--wrap)
+void *__real_malloc(size_t tamanho);
+void *__real_calloc(size_t quantidade, size_t tamanho);
+void *__real_realloc(void *ptr, size_t tamanho);
+void *__real_aligned_alloc(size_t alinhamento, size_t tamanho);
+
+void *__wrap_malloc(size_t tamanho)
+{
+    total_alocacoes++;
+    return __real_malloc(tamanho);
+}
+
+void *__wrap_calloc(size_t quantidade, size_t tamanho)
+{
+    total_alocacoes++;
+    return __real_calloc(quantidade, tamanho);
+}
+
+void *__wrap_realloc(void *ptr, size_t tamanho)
+{
+    total_alocacoes++;
+    return __real_realloc(ptr, tamanho);
+}
+
+void *__wrap_aligned_alloc(size_t alinhamento, size_t tamanho)
+{
+    total_alocacoes++;
+    return __real_aligned_alloc(alinhamento, tamanho);
+}
+
+unsigned long alocacoes_realizadas(void)
+{
+    return total_alocacoes;
+}
@@ -0,0 +1,20 @@
+// ========================================================================
+// alocacoes.h - Contador de alocações dinâmicas
+//
+// O executável é ligado com -Wl,--wrap=malloc (e calloc, realloc,
+// aligned_alloc), então toda alocação feita pelo código da aplicação
+// passa por alocacoes.c e é contada. Chamadas internas da libc não são
+// contadas.
+// ========================================================================
+
+#ifndef ALOCACOES_H
+#define ALOCACOES_H
+
+/**
+ * Total de alocações feitas pela aplicação desde o início do processo
+ *
+ * Compare duas leituras para verificar que um trecho não alocou memória
+ */
+unsigned long alocacoes_realizadas(void);
+
+#endif // ALOCACOES_H
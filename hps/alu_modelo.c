@@ -0,0 +1,676 @@
+// ========================================================================
+// alu_modelo.c - Modelo em software de alu_algoritmos.v
+// ========================================================================
+
+#include "alu_modelo.h"
+#include "mapa_ponte.h"
+#include <string.h>
+
+/* Laços vetoriais: SSE2 no PC, NEON na placa (gcc -mfpu=neon) */
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ALU_MODELO_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ALU_MODELO_NEON
+#endif
+
+// Campos do PIO de configuração (control_data_in)
+#define ZOOM_1X         0x0     // 3'b000
+#define ZOOM_2X         0x1     // 3'b001
+#define ZOOM_4X         0x2     // 3'b010
+#define ZOOM_0_5X       0x3     // 3'b011
+#define ZOOM_0_25X      0x4     // 3'b100
+
+#define ALG_BYPASS      0x0     // 4'b0000
+#define ALG_MEDIA       0x1     // 4'b0001
+#define ALG_VIZINHO_IN  0x2     // 4'b0010
+#define ALG_VIZINHO_OUT 0x3     // 4'b0011
+#define ALG_REPLICACAO  0x4     // 4'b0100
+#define ALG_BILINEAR    0x5     // 4'b0101
+#define ALG_ESCALA      0x6     // 4'b0110
+#define ALG_BYPASS_ALT  0xF     // 4'b1111
+
+/* Janela da imagem fonte que a ALU lê: a ROI de pio_roi quando válida,
+ * senão a imagem inteira (roi_valida/fonte_* em alu_algoritmos.v) */
+typedef struct
+{
+    int x0, y0;
+    int largura, altura;
+} Fonte;
+
+static Fonte ler_fonte(unsigned int roi)
+{
+    Fonte fonte = {0, 0, IMAGE_WIDTH, IMAGE_HEIGHT};
+    int x0 = roi & 0xFF;
+    int y0 = (roi >> ROI_Y_SHIFT) & 0x7F;
+    int largura = (roi >> ROI_LARG_SHIFT) & 0xFF;
+    int altura = (roi >> ROI_ALT_SHIFT) & 0x7F;
+
+    if ((roi & ROI_ATIVA) && largura != 0 && altura != 0 &&
+        x0 + largura <= IMAGE_WIDTH && y0 + altura <= IMAGE_HEIGHT)
+    {
+        fonte.x0 = x0;
+        fonte.y0 = y0;
+        fonte.largura = largura;
+        fonte.altura = altura;
+    }
+    return fonte;
+}
+
+/* Pixel (x, y) da janela fonte */
+#define PIXEL_FONTE(rom, f, x, y) \
+    ((rom)[((f)->y0 + (y)) * IMAGE_WIDTH + (f)->x0 + (x)])
+
+/* Primeira linha da área largura x altura centralizada na tela
+ * (calc_x1 = (640 - calc_larg) >> 1, idem em y) */
+static unsigned char *inicio_area(unsigned char *fb, int largura, int altura)
+{
+    return &fb[((FB_HEIGHT - altura) / 2) * FB_WIDTH + (FB_WIDTH - largura) / 2];
+}
+
+/* Caminhos vetoriais ligados (alu_modelo_variante) */
+static int usar_simd = 1;
+
+// ========================================================================
+// LAÇOS VETORIAIS
+// Cada função trata os blocos completos de uma linha e retorna quantos
+// pixels de saída escreveu; o chamador termina a linha no laço escalar.
+// Retornam 0 quando não há SIMD compilado ou ele foi desligado.
+// ========================================================================
+
+/* destino[x * fator .. x * fator + fator - 1] = fonte[x], fator 2 ou 4 */
+static int ampliar_linha_simd(const unsigned char *fonte, int largura,
+                              unsigned char *destino, int fator)
+{
+    int x = 0;
+    if (!usar_simd)
+        return 0;
+#if defined(ALU_MODELO_SSE2)
+    for (; x + 16 <= largura; x += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)&fonte[x]);
+        __m128i baixo = _mm_unpacklo_epi8(v, v);
+        __m128i alto = _mm_unpackhi_epi8(v, v);
+        unsigned char *d = &destino[x * fator];
+
+        if (fator == 2)
+        {
+            _mm_storeu_si128((__m128i *)&d[0], baixo);
+            _mm_storeu_si128((__m128i *)&d[16], alto);
+        }
+        else
+        {
+            _mm_storeu_si128((__m128i *)&d[0], _mm_unpacklo_epi16(baixo, baixo));
+            _mm_storeu_si128((__m128i *)&d[16], _mm_unpackhi_epi16(baixo, baixo));
+            _mm_storeu_si128((__m128i *)&d[32], _mm_unpacklo_epi16(alto, alto));
+            _mm_storeu_si128((__m128i *)&d[48], _mm_unpackhi_epi16(alto, alto));
+        }
+    }
+#elif defined(ALU_MODELO_NEON)
+    for (; x + 16 <= largura; x += 16)
+    {
+        uint8x16_t v = vld1q_u8(&fonte[x]);
+        if (fator == 2)
+        {
+            uint8x16x2_t par = {{v, v}};
+            vst2q_u8(&destino[x * 2], par);
+        }
+        else
+        {
+            uint8x16x4_t quarteto = {{v, v, v, v}};
+            vst4q_u8(&destino[x * 4], quarteto);
+        }
+    }
+#else
+    (void)fonte; (void)largura; (void)destino; (void)fator;
+#endif
+    return x;
+}
+
+/* destino[x] = fonte[x * fator], fator 2 ou 4 */
+static int reduzir_linha_simd(const unsigned char *fonte, int largura,
+                              unsigned char *destino, int fator)
+{
+    int x = 0;
+    if (!usar_simd)
+        return 0;
+#if defined(ALU_MODELO_SSE2)
+    if (fator == 2)
+    {
+        const __m128i mascara = _mm_set1_epi16(0x00FF);
+        for (; x + 16 <= largura; x += 16)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i *)&fonte[x * 2]);
+            __m128i b = _mm_loadu_si128((const __m128i *)&fonte[x * 2 + 16]);
+            _mm_storeu_si128((__m128i *)&destino[x],
+                             _mm_packus_epi16(_mm_and_si128(a, mascara),
+                                              _mm_and_si128(b, mascara)));
+        }
+    }
+    else
+    {
+        const __m128i mascara = _mm_set1_epi32(0x000000FF);
+        for (; x + 16 <= largura; x += 16)
+        {
+            const __m128i *f = (const __m128i *)&fonte[x * 4];
+            __m128i a = _mm_and_si128(_mm_loadu_si128(&f[0]), mascara);
+            __m128i b = _mm_and_si128(_mm_loadu_si128(&f[1]), mascara);
+            __m128i c = _mm_and_si128(_mm_loadu_si128(&f[2]), mascara);
+            __m128i d = _mm_and_si128(_mm_loadu_si128(&f[3]), mascara);
+            _mm_storeu_si128((__m128i *)&destino[x],
+                             _mm_packus_epi16(_mm_packs_epi32(a, b),
+                                              _mm_packs_epi32(c, d)));
+        }
+    }
+#elif defined(ALU_MODELO_NEON)
+    for (; x + 16 <= largura; x += 16)
+    {
+        if (fator == 2)
+            vst1q_u8(&destino[x], vld2q_u8(&fonte[x * 2]).val[0]);
+        else
+            vst1q_u8(&destino[x], vld4q_u8(&fonte[x * 4]).val[0]);
+    }
+#else
+    (void)fonte; (void)largura; (void)destino; (void)fator;
+#endif
+    return x;
+}
+
+/* Média arredondada de blocos 2x2: linhas a e b da fonte */
+static int media_2x2_simd(const unsigned char *a, const unsigned char *b,
+                          int largura, unsigned char *destino)
+{
+    int x = 0;
+    if (!usar_simd)
+        return 0;
+#if defined(ALU_MODELO_SSE2)
+    const __m128i mascara = _mm_set1_epi16(0x00FF);
+    const __m128i dois = _mm_set1_epi16(2);
+    for (; x + 16 <= largura; x += 16)
+    {
+        __m128i soma[2];
+        int i;
+        for (i = 0; i < 2; i++)
+        {
+            __m128i va = _mm_loadu_si128((const __m128i *)&a[x * 2 + i * 16]);
+            __m128i vb = _mm_loadu_si128((const __m128i *)&b[x * 2 + i * 16]);
+            /* Pares vizinhos somados em 16 bits: byte par + byte ímpar */
+            __m128i pa = _mm_add_epi16(_mm_and_si128(va, mascara), _mm_srli_epi16(va, 8));
+            __m128i pb = _mm_add_epi16(_mm_and_si128(vb, mascara), _mm_srli_epi16(vb, 8));
+            soma[i] = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(pa, pb), dois), 2);
+        }
+        _mm_storeu_si128((__m128i *)&destino[x], _mm_packus_epi16(soma[0], soma[1]));
+    }
+#elif defined(ALU_MODELO_NEON)
+    for (; x + 16 <= largura; x += 16)
+    {
+        uint16x8_t s0 = vaddq_u16(vpaddlq_u8(vld1q_u8(&a[x * 2])),
+                                  vpaddlq_u8(vld1q_u8(&b[x * 2])));
+        uint16x8_t s1 = vaddq_u16(vpaddlq_u8(vld1q_u8(&a[x * 2 + 16])),
+                                  vpaddlq_u8(vld1q_u8(&b[x * 2 + 16])));
+        /* vrshrn: (soma + 2) >> 2, o mesmo arredondamento do hardware */
+        vst1q_u8(&destino[x], vcombine_u8(vrshrn_n_u16(s0, 2), vrshrn_n_u16(s1, 2)));
+    }
+#else
+    (void)a; (void)b; (void)largura; (void)destino;
+#endif
+    return x;
+}
+
+/* Média arredondada de blocos 4x4: linhas[0..3] da fonte */
+static int media_4x4_simd(const unsigned char *const linhas[4], int largura,
+                          unsigned char *destino)
+{
+    int x = 0;
+    if (!usar_simd)
+        return 0;
+#if defined(ALU_MODELO_SSE2)
+    const __m128i mascara16 = _mm_set1_epi16(0x00FF);
+    const __m128i mascara32 = _mm_set1_epi32(0x0000FFFF);
+    const __m128i oito = _mm_set1_epi32(8);
+    for (; x + 8 <= largura; x += 8)
+    {
+        __m128i pares[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
+        __m128i quadras[2];
+        int i, l;
+        for (l = 0; l < 4; l++)
+        {
+            for (i = 0; i < 2; i++)
+            {
+                __m128i v = _mm_loadu_si128((const __m128i *)&linhas[l][x * 4 + i * 16]);
+                pares[i] = _mm_add_epi16(pares[i], _mm_add_epi16(_mm_and_si128(v, mascara16),
+                                                                 _mm_srli_epi16(v, 8)));
+            }
+        }
+        /* Pares de pares em 32 bits: a soma dos 16 pixels de cada bloco */
+        for (i = 0; i < 2; i++)
+        {
+            quadras[i] = _mm_add_epi32(_mm_and_si128(pares[i], mascara32),
+                                       _mm_srli_epi32(pares[i], 16));
+            quadras[i] = _mm_srli_epi32(_mm_add_epi32(quadras[i], oito), 4);
+        }
+        __m128i palavras = _mm_packs_epi32(quadras[0], quadras[1]);
+        _mm_storel_epi64((__m128i *)&destino[x], _mm_packus_epi16(palavras, palavras));
+    }
+#elif defined(ALU_MODELO_NEON)
+    for (; x + 8 <= largura; x += 8)
+    {
+        uint16x8_t p0 = vdupq_n_u16(0);
+        uint16x8_t p1 = vdupq_n_u16(0);
+        int l;
+        for (l = 0; l < 4; l++)
+        {
+            p0 = vpadalq_u8(p0, vld1q_u8(&linhas[l][x * 4]));
+            p1 = vpadalq_u8(p1, vld1q_u8(&linhas[l][x * 4 + 16]));
+        }
+        /* vrshrn: (soma + 8) >> 4 */
+        uint16x8_t medias = vcombine_u16(vrshrn_n_u32(vpaddlq_u16(p0), 4),
+                                         vrshrn_n_u32(vpaddlq_u16(p1), 4));
+        vst1_u8(&destino[x], vmovn_u16(medias));
+    }
+#else
+    (void)linhas; (void)largura; (void)destino;
+#endif
+    return x;
+}
+
+// ========================================================================
+// OPERAÇÕES
+// ========================================================================
+
+/* Copia a janela 1:1 centralizada (S_CLEAR_BORDERS + S_WRITE_RAM 1x) */
+static void desenhar_1x(const unsigned char *rom, const Fonte *f, unsigned char *fb)
+{
+    unsigned char *area = inicio_area(fb, f->largura, f->altura);
+    int y;
+    for (y = 0; y < f->altura; y++)
+    {
+        memcpy(&area[y * FB_WIDTH], &PIXEL_FONTE(rom, f, 0, y), f->largura);
+    }
+}
+
+/* Amplia por fator inteiro replicando cada pixel em blocos fator x fator.
+ * As linhas 1..fator-1 de cada bloco são cópias da primeira */
+static void desenhar_ampliado(const unsigned char *rom, const Fonte *f,
+                              unsigned char *fb, int fator)
+{
+    unsigned char *area = inicio_area(fb, f->largura * fator, f->altura * fator);
+    int x, y, dx, dy;
+    for (y = 0; y < f->altura; y++)
+    {
+        const unsigned char *fonte = &PIXEL_FONTE(rom, f, 0, y);
+        unsigned char *linha = &area[y * fator * FB_WIDTH];
+
+        for (x = ampliar_linha_simd(fonte, f->largura, linha, fator); x < f->largura; x++)
+        {
+            for (dx = 0; dx < fator; dx++)
+            {
+                linha[x * fator + dx] = fonte[x];
+            }
+        }
+        for (dy = 1; dy < fator; dy++)
+        {
+            memcpy(&linha[dy * FB_WIDTH], linha, f->largura * fator);
+        }
+    }
+}
+
+/* Reduz selecionando 1 pixel a cada 'fator' (VZ05_PROCESS_PIXEL) */
+static void desenhar_vizinho_reduzido(const unsigned char *rom, const Fonte *f,
+                                      unsigned char *fb, int fator)
+{
+    int largura = f->largura / fator;
+    int altura = f->altura / fator;
+    unsigned char *area = inicio_area(fb, largura, altura);
+    int x, y;
+    for (y = 0; y < altura; y++)
+    {
+        const unsigned char *fonte = &PIXEL_FONTE(rom, f, 0, y * fator);
+        unsigned char *linha = &area[y * FB_WIDTH];
+
+        for (x = reduzir_linha_simd(fonte, largura, linha, fator); x < largura; x++)
+        {
+            linha[x] = fonte[x * fator];
+        }
+    }
+}
+
+/* Reduz pela média arredondada de blocos fator x fator (S_MD_STREAM).
+ * Blocos incompletos na borda direita e inferior da janela são
+ * descartados, como na divisão inteira da área */
+static void desenhar_media(const unsigned char *rom, const Fonte *f,
+                           unsigned char *fb, int fator)
+{
+    int largura = f->largura / fator;
+    int altura = f->altura / fator;
+    unsigned char *area = inicio_area(fb, largura, altura);
+    int x, y, bx, by;
+    int arredondamento = (fator * fator) / 2;
+    int deslocamento = (fator == 2) ? 2 : 4;
+
+    for (y = 0; y < altura; y++)
+    {
+        const unsigned char *linhas[4];
+        unsigned char *linha = &area[y * FB_WIDTH];
+
+        for (by = 0; by < fator; by++)
+        {
+            linhas[by] = &PIXEL_FONTE(rom, f, 0, y * fator + by);
+        }
+
+        if (fator == 2)
+            x = media_2x2_simd(linhas[0], linhas[1], largura, linha);
+        else
+            x = media_4x4_simd(linhas, largura, linha);
+
+        for (; x < largura; x++)
+        {
+            int soma = 0;
+            for (by = 0; by < fator; by++)
+            {
+                for (bx = 0; bx < fator; bx++)
+                {
+                    soma += linhas[by][x * fator + bx];
+                }
+            }
+            linha[x] = (unsigned char)((soma + arredondamento) >> deslocamento);
+        }
+    }
+}
+
+/* Amplia por interpolação bilinear com pesos em quartos (ramo 4'b0101).
+ * O pixel (X, Y) da área fica entre as colunas x0 = X/fator e x1 = x0+1
+ * (repetindo a borda da janela), com peso fx4/4 em x1; idem nas linhas.
+ * A soma é feita como no hardware: horizontal primeiro, depois vertical,
+ * e uma única divisão arredondada por 16 no fim */
+static void desenhar_bilinear(const unsigned char *rom, const Fonte *f,
+                              unsigned char *fb, int fator)
+{
+    unsigned char *area = inicio_area(fb, f->largura * fator, f->altura * fator);
+    int x, y;
+    int passo = 4 / fator;  /* quartos por pixel de saída */
+
+    for (y = 0; y < f->altura * fator; y++)
+    {
+        int y0 = y / fator;
+        int y1 = (y0 < f->altura - 1) ? y0 + 1 : y0;
+        int fy4 = (y % fator) * passo;
+        const unsigned char *sup = &PIXEL_FONTE(rom, f, 0, y0);
+        const unsigned char *inf = &PIXEL_FONTE(rom, f, 0, y1);
+        unsigned char *linha = &area[y * FB_WIDTH];
+
+        for (x = 0; x < f->largura * fator; x++)
+        {
+            int x0 = x / fator;
+            int x1 = (x0 < f->largura - 1) ? x0 + 1 : x0;
+            int fx4 = (x % fator) * passo;
+            int h_sup = (4 - fx4) * sup[x0] + fx4 * sup[x1];
+            int h_inf = (4 - fx4) * inf[x0] + fx4 * inf[x1];
+
+            linha[x] = (unsigned char)(((4 - fy4) * h_sup + fy4 * h_inf + 8) >> 4);
+        }
+    }
+}
+
+/* Área da escala DDA (S_ESC_MEDIDA): quantos n têm n * passo dentro da
+ * janela fonte, limitado à tela */
+static int medir_escala(unsigned int passo, int fonte, int tela)
+{
+    unsigned long long acumulado = 0;
+    int n = 0;
+
+    while (acumulado < ((unsigned long long)fonte << 16) && n < tela)
+    {
+        acumulado += passo;
+        n++;
+    }
+    return n;
+}
+
+/* Escala por passos 16.16 (ramo 4'b0110): o pixel (X, Y) da área lê o
+ * pixel (floor(X * passo_x), floor(Y * passo_y)) da janela fonte */
+static void desenhar_escala(const unsigned char *rom, const Fonte *f, unsigned char *fb,
+                            unsigned int passo_x, unsigned int passo_y)
+{
+    int largura = medir_escala(passo_x, f->largura, FB_WIDTH);
+    int altura = medir_escala(passo_y, f->altura, FB_HEIGHT);
+    unsigned char *area = inicio_area(fb, largura, altura);
+    int x, y;
+
+    for (y = 0; y < altura; y++)
+    {
+        const unsigned char *fonte =
+            &PIXEL_FONTE(rom, f, 0, (int)(((unsigned long long)y * passo_y) >> 16));
+        unsigned char *linha = &area[y * FB_WIDTH];
+
+        for (x = 0; x < largura; x++)
+        {
+            linha[x] = fonte[((unsigned long long)x * passo_x) >> 16];
+        }
+    }
+}
+
+const char *alu_modelo_variante(int simd)
+{
+    usar_simd = simd;
+#if defined(ALU_MODELO_SSE2)
+    return simd ? "SSE2" : "escalar";
+#elif defined(ALU_MODELO_NEON)
+    return simd ? "NEON" : "escalar";
+#else
+    return "escalar";
+#endif
+}
+
+void alu_modelo_executar(int config, unsigned int passo_x, unsigned int passo_y,
+                         unsigned int roi, const unsigned char *rom,
+                         unsigned char *framebuffer)
+{
+    int zoom = config & 0x7;
+    int tipo = (config >> 3) & 0xF;
+    Fonte fonte = ler_fonte(roi);
+
+    switch (tipo)
+    {
+    case ALG_BYPASS:
+    case ALG_BYPASS_ALT:
+        /* Só a área ativa é escrita: o VGA pinta as bordas de preto e o
+         * resto do framebuffer guarda o que as operações anteriores deixaram */
+        desenhar_1x(rom, &fonte, framebuffer);
+        break;
+
+    case ALG_MEDIA:
+        if (zoom == ZOOM_0_5X)
+            desenhar_media(rom, &fonte, framebuffer, 2);
+        else if (zoom == ZOOM_0_25X)
+            desenhar_media(rom, &fonte, framebuffer, 4);
+        else
+            desenhar_1x(rom, &fonte, framebuffer);
+        break;
+
+    case ALG_VIZINHO_IN:
+    case ALG_REPLICACAO:
+        /* As duas FSMs são idênticas no hardware */
+        if (zoom == ZOOM_4X)
+            desenhar_ampliado(rom, &fonte, framebuffer, 4);
+        else if (zoom == ZOOM_2X)
+            desenhar_ampliado(rom, &fonte, framebuffer, 2);
+        else
+            desenhar_1x(rom, &fonte, framebuffer);
+        break;
+
+    case ALG_BILINEAR:
+        if (zoom == ZOOM_4X)
+            desenhar_bilinear(rom, &fonte, framebuffer, 4);
+        else if (zoom == ZOOM_2X)
+            desenhar_bilinear(rom, &fonte, framebuffer, 2);
+        else
+            desenhar_1x(rom, &fonte, framebuffer); /* pesos nulos: cópia 1:1 */
+        break;
+
+    case ALG_ESCALA:
+        desenhar_escala(rom, &fonte, framebuffer, passo_x, passo_y);
+        break;
+
+    case ALG_VIZINHO_OUT:
+        if (zoom == ZOOM_0_5X)
+            desenhar_vizinho_reduzido(rom, &fonte, framebuffer, 2);
+        else if (zoom == ZOOM_0_25X)
+            desenhar_vizinho_reduzido(rom, &fonte, framebuffer, 4);
+        else
+            desenhar_1x(rom, &fonte, framebuffer);
+        break;
+
+    default:
+        /* Sem ramo no case(tipo_alg): a FSM fica parada */
+        break;
+    }
+}
+
+/* Área ativa do opcode na tela (calc_x1/calc_larg em alu_algoritmos.v).
+ * Retorna 0 para opcodes sem FSM e para a escala, cuja área sai dos
+ * passos (medir_escala) */
+static int area_ativa(int config, const Fonte *fonte, int *largura, int *altura)
+{
+    int zoom = config & 0x7;
+    int tipo = (config >> 3) & 0xF;
+
+    *largura = fonte->largura;
+    *altura = fonte->altura;
+
+    switch (tipo)
+    {
+    case ALG_BYPASS:
+    case ALG_BYPASS_ALT:
+        return 1;
+
+    case ALG_VIZINHO_IN:
+    case ALG_REPLICACAO:
+    case ALG_BILINEAR:
+        if (zoom == ZOOM_4X || zoom == ZOOM_2X)
+        {
+            int fator = (zoom == ZOOM_4X) ? 4 : 2;
+            *largura *= fator;
+            *altura *= fator;
+        }
+        return 1;
+
+    case ALG_MEDIA:
+    case ALG_VIZINHO_OUT:
+        if (zoom == ZOOM_0_5X || zoom == ZOOM_0_25X)
+        {
+            int fator = (zoom == ZOOM_0_25X) ? 4 : 2;
+            *largura /= fator;
+            *altura /= fator;
+        }
+        return 1;
+
+    default:
+        return 0;
+    }
+}
+
+unsigned int alu_modelo_ciclos(int config, unsigned int passo_x, unsigned int passo_y,
+                               unsigned int roi)
+{
+    int tipo = (config >> 3) & 0xF;
+    Fonte fonte = ler_fonte(roi);
+    int largura, altura;
+    unsigned int custo;
+
+    if (tipo == ALG_ESCALA)
+    {
+        largura = medir_escala(passo_x, fonte.largura, FB_WIDTH);
+        altura = medir_escala(passo_y, fonte.altura, FB_HEIGHT);
+
+        /* IDLE + medida (um ciclo por pixel da maior dimensão e um de
+         * parada) + INICIO + 1 pixel da área por ciclo + esvaziar
+         * estágios 1 e 2 + DONE */
+        return 1 + (largura > altura ? largura : altura) + 1 + 1 +
+               largura * altura + 2 + 1;
+    }
+
+    if (!area_ativa(config, &fonte, &largura, &altura))
+        return 0;
+
+    switch (tipo)
+    {
+    case ALG_VIZINHO_IN:
+    case ALG_REPLICACAO:
+        /* IDLE + 1 pixel da área por ciclo + esvaziar estágios 1 e 2 + DONE */
+        return 1 + largura * altura + 2 + 1;
+
+    case ALG_BILINEAR:
+        /* IDLE + carga da linha 0 + leitura de (0, 1) + 1 pixel da área por
+         * ciclo + esvaziar estágios 1 e 2 + DONE */
+        return 1 + fonte.largura + 1 + largura * altura + 2 + 1;
+
+    case ALG_MEDIA:
+        /* IDLE + 1 pixel da janela fonte por ciclo + DRAIN + DONE */
+        return 1 + fonte.largura * fonte.altura + 1 + 1;
+
+    case ALG_VIZINHO_OUT:
+        custo = 4;      /* PROCESS, SET_ROM_ADDR, READ_ROM, WRITE_RAM */
+        break;
+
+    default:
+        custo = 3;      /* bypass: PROCESS, READ_ROM, WRITE_RAM */
+        break;
+    }
+
+    /* IDLE + salto até a área + por linha (pixels + salto ao fim) +
+     * PROCESS com ram_counter >= RAM_SIZE + DONE */
+    return 1 + 1 + altura * (largura * custo + 1) + 1 + 1;
+}
+
+unsigned int alu_modelo_ciclos_limpeza(int config, unsigned int roi)
+{
+    int tipo = (config >> 3) & 0xF;
+    Fonte fonte = ler_fonte(roi);
+    int largura, altura;
+
+    if (!area_ativa(config, &fonte, &largura, &altura))
+        return 0;
+
+    /* Os pipelines do vizinho in, da média e da escala não visitam pixels
+     * fora da área; as varreduras gastam um ciclo no salto inicial e um no
+     * fim de cada linha */
+    if (tipo == ALG_VIZINHO_IN || tipo == ALG_REPLICACAO || tipo == ALG_MEDIA ||
+        tipo == ALG_BILINEAR)
+        return 0;
+    return 1 + altura;
+}
+
+void alu_modelo_acessos(int config, unsigned int passo_x, unsigned int passo_y,
+                        unsigned int roi, unsigned int *leituras_rom,
+                        unsigned int *escritas_fb)
+{
+    int tipo = (config >> 3) & 0xF;
+    Fonte fonte = ler_fonte(roi);
+    int largura, altura;
+
+    *leituras_rom = 0;
+    *escritas_fb = 0;
+
+    if (tipo == ALG_ESCALA)
+    {
+        largura = medir_escala(passo_x, fonte.largura, FB_WIDTH);
+        altura = medir_escala(passo_y, fonte.altura, FB_HEIGHT);
+    }
+    else if (!area_ativa(config, &fonte, &largura, &altura))
+    {
+        return;
+    }
+
+    /* Um pixel escrito por pixel da área, lido da ROM em todas as FSMs
+     * exceto a média, que lê cada pixel da janela uma vez, e o bilinear,
+     * que antes carrega a linha 0 e o primeiro pixel inferior */
+    *escritas_fb = largura * altura;
+    if (tipo == ALG_MEDIA)
+        *leituras_rom = fonte.largura * fonte.altura;
+    else if (tipo == ALG_BILINEAR)
+        *leituras_rom = fonte.largura + 1 + largura * altura;
+    else
+        *leituras_rom = largura * altura;
+}
@@ -0,0 +1,99 @@
+// ========================================================================
+// alu_modelo.h
+// Modelo em software da ALU do coprocessador (alu_algoritmos.v)
+//
+// Reproduz bit a bit o conteúdo que a FSM da FPGA deixa no framebuffer
+// 640x480 (blocoram) ao final de cada operação. Usado pelo backend
+// "modelo" para executar o pipeline de main.c fora da placa e como
+// referência para conferir o framebuffer da simulação e da FPGA.
+//
+// Cópia, médias, vizinho e replicação têm laços SSE2 (PC) e NEON (placa)
+// com o mesmo resultado dos escalares; alu_modelo_variante() alterna.
+//
+// Cada operação escreve só a sua área ativa; fora dela o framebuffer
+// guarda o que as operações anteriores deixaram, e é o estágio de saída
+// do VGA (overlay_vga.v) que pinta essas bordas de preto.
+// ========================================================================
+
+#ifndef ALU_MODELO_H
+#define ALU_MODELO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Executa uma operação completa da ALU
+ *
+ * @param config: Valor escrito no PIO de 10 bits
+ *                [2:0] = zoom_enable, [6:3] = tipo_alg
+ * @param passo_x, passo_y: pio_passo_x/pio_passo_y (16.16), usados só
+ *                          pela escala DDA (tipo_alg 0110)
+ * @param roi: pio_roi; se válida, a operação lê só essa janela da fonte
+ *             e centraliza na tela a área derivada do tamanho dela
+ * @param rom: Imagem fonte 160x120 (onchip_memory2_1)
+ * @param framebuffer: Framebuffer 640x480 (blocoram)
+ *
+ * Opcodes sem tratamento na FSM (tipo_alg 0111..1110) não alteram
+ * o framebuffer, assim como no hardware
+ */
+void alu_modelo_executar(int config, unsigned int passo_x, unsigned int passo_y,
+                         unsigned int roi, const unsigned char *rom,
+                         unsigned char *framebuffer);
+
+/**
+ * Escolhe os laços escalares ou os vetoriais
+ *
+ * @param simd: 1 para usar SSE2/NEON quando compilados (padrão), 0 para
+ *              forçar os laços escalares
+ * @return Nome da variante em uso: "SSE2", "NEON" ou "escalar"
+ */
+const char *alu_modelo_variante(int simd);
+
+/**
+ * Ciclos de clk25 que a FSM gasta para executar uma operação
+ *
+ * @param config: Valor escrito no PIO de 10 bits
+ * @param passo_x, passo_y: pio_passo_x/pio_passo_y (16.16)
+ * @param roi: pio_roi
+ * @return Ciclos do primeiro clock após o reset até done=1 (o valor que
+ *         o contador de pio_status congela), ou 0 se a FSM nunca termina
+ */
+unsigned int alu_modelo_ciclos(int config, unsigned int passo_x, unsigned int passo_y,
+                               unsigned int roi);
+
+/**
+ * Parte de alu_modelo_ciclos() gasta fora da área ativa
+ *
+ * @param config: Valor escrito no PIO de 10 bits
+ * @param roi: pio_roi
+ * @return Ciclos de S_PROCESS_PIXEL em saltos de borda (valor de pio_limpeza)
+ */
+unsigned int alu_modelo_ciclos_limpeza(int config, unsigned int roi);
+
+/**
+ * Acessos à memória de uma operação (contadores 2 e 3 de contadores_alu.v)
+ *
+ * @param config, passo_x, passo_y, roi: Como em alu_modelo_ciclos()
+ * @param leituras_rom: Dados de rom_data_in consumidos pela FSM
+ * @param escritas_fb: Ciclos com ram_wren_out em 1
+ *
+ * Ambos ficam em 0 para opcodes sem FSM
+ */
+void alu_modelo_acessos(int config, unsigned int passo_x, unsigned int passo_y,
+                        unsigned int roi, unsigned int *leituras_rom,
+                        unsigned int *escritas_fb);
+
+/**
+ * Framebuffer 640x480 do backend modelo
+ *
+ * @return Ponteiro para o framebuffer, ou NULL se o coprocessador
+ *         não foi iniciado com o backend modelo
+ */
+unsigned char *modelo_framebuffer(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALU_MODELO_H
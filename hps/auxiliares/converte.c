@@ -1,58 +1,509 @@
+// ========================================================================
+// converte.c - Conversor em lote de imagens para 160x120 em tons de cinza
+//
+// Decodifica JPEG/PNG/BMP/GIF/TGA/PNM com stb_image em um conjunto de
+// threads, converte para cinza com a mesma luma inteira de bitmap.c e
+// reduz (ou amplia) para 160x120 pela média de área de
+// redimensionar_cinza(). Cada imagem vira um BMP de 8 bits no diretório
+// de saída ou um quadro de um pacote (pacote.h), gravados em paralelo.
+//
+// Uso: ./converte [-j threads] [-o diretorio | -p pacote] [-l lista] entradas...
+//   entradas: arquivos ou diretórios (as imagens de cada diretório, sem
+//             subdiretórios, em ordem alfabética)
+//   -l lista: um caminho por linha ("-" = entrada padrão; # comenta)
+// Compilar: make ferramentas
+// ========================================================================
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "../bitmap.h"
+#include "../pacote.h"
+
 #define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_LINEAR
+#define STBI_NO_HDR
 #include "stb_image.h"
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "stb_image_write.h"
 
-void converter_para_bmp() {
-    char caminho[300];
-    printf("Digite o caminho da imagem JPEG/PNG: ");
-    scanf("%s", caminho);
+#define LARGURA PACOTE_LARGURA
+#define ALTURA PACOTE_ALTURA
 
-    int largura, altura, canais;
-    unsigned char *img = stbi_load(caminho, &largura, &altura, &canais, 3);
-    if (!img) {
-        printf("Erro ao carregar a imagem.\n");
-        return;
+typedef struct {
+    char *caminho;
+    char nome[PACOTE_NOME_MAXIMO];  // arquivo sem diretório nem extensão
+    int convertida;
+} Tarefa;
+
+typedef struct {
+    Tarefa *tarefas;
+    int total;
+    int capacidade;
+    int proxima;                    // próxima tarefa livre (atômico)
+    const char *diretorio;          // modo BMP
+    int fd_pacote;                  // modo pacote (-1 = BMP)
+    uint64_t offset_quadros;
+} Lote;
+
+// ========================================================================
+// LISTA DE ENTRADAS
+// ========================================================================
+
+static const char *extensoes[] = {
+    "jpg", "jpeg", "png", "bmp", "gif", "tga", "pgm", "ppm", "pnm", "psd", "pic"
+};
+
+static const char *extensao(const char *caminho) {
+    const char *ponto = strrchr(caminho, '.');
+    const char *barra = strrchr(caminho, '/');
+    return (ponto && (!barra || ponto > barra)) ? ponto + 1 : "";
+}
+
+static int e_imagem(const char *caminho) {
+    size_t i;
+    for (i = 0; i < sizeof(extensoes) / sizeof(extensoes[0]); i++) {
+        if (strcasecmp(extensao(caminho), extensoes[i]) == 0) {
+            return 1;
+        }
     }
+    return 0;
+}
 
-    // Dimensões de saída
-    int newW = 160;
-    int newH = 120;
+static int adicionar(Lote *lote, const char *caminho) {
+    if (lote->total == lote->capacidade) {
+        int capacidade = lote->capacidade ? lote->capacidade * 2 : 64;
+        Tarefa *tarefas = realloc(lote->tarefas, capacidade * sizeof(Tarefa));
+        if (!tarefas) {
+            fprintf(stderr, "ERRO: Falha ao alocar a lista de entradas\n");
+            return -1;
+        }
+        lote->tarefas = tarefas;
+        lote->capacidade = capacidade;
+    }
 
-    unsigned char out[newW * newH];
+    Tarefa *t = &lote->tarefas[lote->total];
+    const char *base = strrchr(caminho, '/');
+    base = base ? base + 1 : caminho;
+    const char *ext = extensao(base);
+    size_t tamanho = ext[0] ? (size_t)(ext - 1 - base) : strlen(base);
+    if (tamanho >= PACOTE_NOME_MAXIMO) {
+        tamanho = PACOTE_NOME_MAXIMO - 1;
+    }
+    memcpy(t->nome, base, tamanho);
+    t->nome[tamanho] = '\0';
+    t->caminho = strdup(caminho);
+    t->convertida = 0;
+    if (!t->caminho) {
+        return -1;
+    }
+    lote->total++;
+    return 0;
+}
 
-    // Redimensionar e converter para escala de cinza       
-    for (int y = 0; y < newH; y++) {
-        for (int x = 0; x < newW; x++) {
-            int srcX = x * largura / newW;
-            int srcY = y * altura / newH;
+static int comparar_nomes(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
 
-            int idx = (srcY * largura + srcX) * 3;  // RGB
+/* Um arquivo, ou as imagens de um diretório em ordem alfabética */
+static int adicionar_entrada(Lote *lote, const char *caminho) {
+    struct stat st;
+    if (stat(caminho, &st) != 0) {
+        fprintf(stderr, "ERRO: '%s': %s\n", caminho, strerror(errno));
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return adicionar(lote, caminho);
+    }
 
-            unsigned char r = img[idx];
-            unsigned char g = img[idx + 1];
-            unsigned char b = img[idx + 2];
+    DIR *dir = opendir(caminho);
+    if (!dir) {
+        fprintf(stderr, "ERRO: '%s': %s\n", caminho, strerror(errno));
+        return -1;
+    }
+    char **nomes = NULL;
+    int total = 0, capacidade = 0, i, resultado = 0;
+    struct dirent *d;
+    while ((d = readdir(dir)) != NULL) {
+        if (d->d_name[0] == '.' || !e_imagem(d->d_name)) {
+            continue;
+        }
+        if (total == capacidade) {
+            capacidade = capacidade ? capacidade * 2 : 64;
+            char **novos = realloc(nomes, capacidade * sizeof(char *));
+            if (!novos) {
+                resultado = -1;
+                break;
+            }
+            nomes = novos;
+        }
+        size_t bytes = strlen(caminho) + strlen(d->d_name) + 2;
+        nomes[total] = malloc(bytes);
+        if (!nomes[total]) {
+            resultado = -1;
+            break;
+        }
+        snprintf(nomes[total++], bytes, "%s/%s", caminho, d->d_name);
+    }
+    closedir(dir);
 
-            // conversão para cinza (luma)
-            unsigned char gray = 0.299*r + 0.587*g + 0.114*b;
+    qsort(nomes, total, sizeof(char *), comparar_nomes);
+    for (i = 0; i < total; i++) {
+        if (resultado == 0) {
+            resultado = adicionar(lote, nomes[i]);
+        }
+        free(nomes[i]);
+    }
+    free(nomes);
+    return resultado;
+}
+
+static int comparar_tarefas(const void *a, const void *b) {
+    const Tarefa *ta = *(const Tarefa *const *)a;
+    const Tarefa *tb = *(const Tarefa *const *)b;
+    int c = strcmp(ta->nome, tb->nome);
+    return c ? c : (ta < tb ? -1 : ta > tb);
+}
+
+typedef char NomeQuadro[PACOTE_NOME_MAXIMO];
 
-            out[y * newW + x] = gray;
+static int comparar_nome_quadro(const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+}
+
+/* Nome mantido por alguma entrada (originais, ordenados) ou já dado a uma
+ * entrada renomeada */
+static int nome_em_uso(const char *nome, const NomeQuadro *originais, int total_originais,
+                       const NomeQuadro *novos, int total_novos) {
+    int i;
+    if (bsearch(nome, originais, total_originais, sizeof(NomeQuadro), comparar_nome_quadro)) {
+        return 1;
+    }
+    for (i = 0; i < total_novos; i++) {
+        if (strcmp(nome, novos[i]) == 0) {
+            return 1;
         }
     }
+    return 0;
+}
+
+/* Nomes repetidos (foto.jpg e foto.png, ou o mesmo nome em dois diretórios)
+ * ganham -2, -3...: duas threads nunca gravam o mesmo BMP. O sufixo pula
+ * nomes que já existem no lote, também quando o nome é cortado para caber:
+ * a.png, a.jpg e a-2.png viram a, a-3 e a-2 */
+static int desambiguar_nomes(Lote *lote) {
+    Tarefa **ordem = malloc(lote->total * sizeof(Tarefa *));
+    NomeQuadro *originais = malloc(lote->total * sizeof(NomeQuadro));
+    NomeQuadro *novos = malloc(lote->total * sizeof(NomeQuadro));
+    int i, total_originais = 0, total_novos = 0, n = 2;
+    const Tarefa *grupo = NULL;
+
+    if (!ordem || !originais || !novos) {
+        fprintf(stderr, "ERRO: Falha ao alocar a lista de entradas\n");
+        free(ordem);
+        free(originais);
+        free(novos);
+        return -1;
+    }
+    for (i = 0; i < lote->total; i++) {
+        ordem[i] = &lote->tarefas[i];
+    }
+    qsort(ordem, lote->total, sizeof(Tarefa *), comparar_tarefas);
+    for (i = 0; i < lote->total; i++) {
+        if (i == 0 || strcmp(ordem[i]->nome, ordem[i - 1]->nome) != 0) {
+            memcpy(originais[total_originais++], ordem[i]->nome, sizeof(NomeQuadro));
+        }
+    }
+
+    // O primeiro de cada grupo (na ordem de entrada) mantém o nome
+    for (i = 0; i < lote->total; i++) {
+        if (!grupo || strcmp(ordem[i]->nome, grupo->nome) != 0) {
+            grupo = ordem[i];
+            n = 2;
+            continue;
+        }
+        char *nome = novos[total_novos];
+        do {
+            char sufixo[16];
+            int bytes = snprintf(sufixo, sizeof(sufixo), "-%d", n++);
+            size_t tamanho = strlen(grupo->nome);
+            if (tamanho + bytes >= PACOTE_NOME_MAXIMO) {
+                tamanho = PACOTE_NOME_MAXIMO - 1 - bytes;
+            }
+            memcpy(nome, grupo->nome, tamanho);
+            memcpy(nome + tamanho, sufixo, bytes + 1);
+        } while (nome_em_uso(nome, originais, total_originais, novos, total_novos));
+        memcpy(ordem[i]->nome, nome, sizeof(NomeQuadro));
+        total_novos++;
+    }
+    free(ordem);
+    free(originais);
+    free(novos);
+    return 0;
+}
+
+/* Um caminho por linha; linhas vazias e começando com # são ignoradas */
+static int ler_lista(Lote *lote, const char *lista) {
+    FILE *arquivo = strcmp(lista, "-") == 0 ? stdin : fopen(lista, "r");
+    char linha[4096];
+    int resultado = 0;
+
+    if (!arquivo) {
+        fprintf(stderr, "ERRO: '%s': %s\n", lista, strerror(errno));
+        return -1;
+    }
+    while (resultado == 0 && fgets(linha, sizeof(linha), arquivo)) {
+        linha[strcspn(linha, "\r\n")] = '\0';
+        if (linha[0] != '\0' && linha[0] != '#') {
+            resultado = adicionar_entrada(lote, linha);
+        }
+    }
+    if (arquivo != stdin) {
+        fclose(arquivo);
+    }
+    return resultado;
+}
+
+// ========================================================================
+// CONVERSÃO
+// ========================================================================
+
+/* Decodifica, converte para cinza e reduz para o quadro 160x120 */
+static int converter(const char *caminho, unsigned char *quadro) {
+    int largura, altura, canais;
+    unsigned char *rgb = stbi_load(caminho, &largura, &altura, &canais, 3);
+    if (!rgb) {
+        fprintf(stderr, "ERRO: '%s': %s\n", caminho, stbi_failure_reason());
+        return -1;
+    }
+
+    // Cinza no lugar: o pixel i é gravado no byte i, atrás dos 3i já lidos.
+    // Mesma luma de bitmap.c: (299R + 587G + 114B) / 1000, em inteiros
+    size_t total = (size_t)largura * altura, i;
+    for (i = 0; i < total; i++) {
+        const unsigned char *p = &rgb[i * 3];
+        rgb[i] = (unsigned char)((299 * p[0] + 587 * p[1] + 114 * p[2]) / 1000);
+    }
+
+    int resultado = redimensionar_cinza(rgb, largura, altura, quadro, LARGURA, ALTURA);
+    stbi_image_free(rgb);
+    return resultado;
+}
 
-    stbi_image_free(img);
+static int gravar(Lote *lote, int indice, const unsigned char *quadro) {
+    if (lote->fd_pacote < 0) {
+        char saida[4096];
+        snprintf(saida, sizeof(saida), "%s/%s.bmp", lote->diretorio,
+                 lote->tarefas[indice].nome);
+        return salvar_bitmap(saida, (unsigned char *)quadro, LARGURA, ALTURA);
+    }
 
-    // gera arquivo bmp
-    if (!stbi_write_bmp("saida.bmp", newW, newH, 1, out)) {
-        printf("Erro ao salvar BMP.\n");
-        return;
+    // Cada tarefa tem seu lugar fixo no pacote: pwrite sem trava
+    off_t offset = lote->offset_quadros + (uint64_t)indice * PACOTE_BYTES_QUADRO;
+    if (pwrite(lote->fd_pacote, quadro, PACOTE_BYTES_QUADRO, offset) != PACOTE_BYTES_QUADRO) {
+        fprintf(stderr, "ERRO: Falha ao gravar o quadro de '%s': %s\n",
+                lote->tarefas[indice].caminho, strerror(errno));
+        return -1;
     }
+    return 0;
+}
 
-    printf("Imagem gerada: saida.bmp\n");
+static void *trabalhador(void *arg) {
+    Lote *lote = (Lote *)arg;
+    unsigned char quadro[PACOTE_BYTES_QUADRO];
+
+    for (;;) {
+        int i = __atomic_fetch_add(&lote->proxima, 1, __ATOMIC_RELAXED);
+        if (i >= lote->total) {
+            break;
+        }
+        lote->tarefas[i].convertida =
+            converter(lote->tarefas[i].caminho, quadro) == 0 && gravar(lote, i, quadro) == 0;
+    }
+    return NULL;
 }
 
-int main() {
-    converter_para_bmp();
+// ========================================================================
+// PACOTE
+// ========================================================================
+
+/* Fecha o pacote: junta os quadros das conversões que falharam para manter
+ * os quadros contíguos e grava o índice e o header */
+static int finalizar_pacote(Lote *lote, int convertidas) {
+    PacoteHeader header;
+    PacoteEntrada entrada;
+    unsigned char quadro[PACOTE_BYTES_QUADRO];
+    int i, n = 0;
+
+    for (i = 0; i < lote->total; i++) {
+        if (!lote->tarefas[i].convertida) {
+            continue;
+        }
+        uint64_t origem = lote->offset_quadros + (uint64_t)i * PACOTE_BYTES_QUADRO;
+        uint64_t destino = lote->offset_quadros + (uint64_t)n * PACOTE_BYTES_QUADRO;
+        if (origem != destino &&
+            (pread(lote->fd_pacote, quadro, sizeof(quadro), origem) != sizeof(quadro) ||
+             pwrite(lote->fd_pacote, quadro, sizeof(quadro), destino) != sizeof(quadro))) {
+            return -1;
+        }
+
+        memset(&entrada, 0, sizeof(entrada));
+        strcpy(entrada.nome, lote->tarefas[i].nome);
+        entrada.offset = destino;
+        if (pwrite(lote->fd_pacote, &entrada, sizeof(entrada),
+                   sizeof(PacoteHeader) + (uint64_t)n * sizeof(entrada)) != sizeof(entrada)) {
+            return -1;
+        }
+        n++;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.assinatura, PACOTE_ASSINATURA, sizeof(header.assinatura));
+    header.versao = PACOTE_VERSAO;
+    header.total = convertidas;
+    header.largura = LARGURA;
+    header.altura = ALTURA;
+    header.bytes_quadro = PACOTE_BYTES_QUADRO;
+    header.alinhamento = PACOTE_ALINHAMENTO;
+    header.offset_indice = sizeof(PacoteHeader);
+    header.offset_quadros = lote->offset_quadros;
+    if (pwrite(lote->fd_pacote, &header, sizeof(header), 0) != sizeof(header) ||
+        ftruncate(lote->fd_pacote,
+                  lote->offset_quadros + (uint64_t)n * PACOTE_BYTES_QUADRO) != 0) {
+        return -1;
+    }
     return 0;
 }
+
+static void uso(const char *programa) {
+    fprintf(stderr,
+            "Uso: %s [-j threads] [-o diretorio | -p pacote] [-l lista] entradas...\n"
+            "  entradas     arquivos de imagem ou diretórios\n"
+            "  -l lista     lê os caminhos de um arquivo (\"-\" = entrada padrão)\n"
+            "  -o diretorio grava um BMP 160x120 por imagem (padrão: .)\n"
+            "  -p pacote    grava todas as imagens em um pacote de quadros\n"
+            "  -j threads   número de threads (padrão: núcleos disponíveis)\n",
+            programa);
+}
+
+static double agora_segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    Lote lote = {0};
+    const char *pacote = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int opcao, i;
+
+    lote.diretorio = ".";
+    lote.fd_pacote = -1;
+    while ((opcao = getopt(argc, argv, "j:o:p:l:h")) != -1) {
+        switch (opcao) {
+        case 'j':
+            threads = atol(optarg);
+            break;
+        case 'o':
+            lote.diretorio = optarg;
+            break;
+        case 'p':
+            pacote = optarg;
+            break;
+        case 'l':
+            if (ler_lista(&lote, optarg) != 0) {
+                return 1;
+            }
+            break;
+        default:
+            uso(argv[0]);
+            return opcao == 'h' ? 0 : 1;
+        }
+    }
+    for (i = optind; i < argc; i++) {
+        if (adicionar_entrada(&lote, argv[i]) != 0) {
+            return 1;
+        }
+    }
+    if (lote.total == 0 || threads <= 0) {
+        uso(argv[0]);
+        return 1;
+    }
+    if (desambiguar_nomes(&lote) != 0) {
+        return 1;
+    }
+    if (threads > lote.total) {
+        threads = lote.total;
+    }
+
+    if (pacote) {
+        // Índice com lugar para todas as entradas; os quadros logo depois
+        lote.offset_quadros = sizeof(PacoteHeader) + (uint64_t)lote.total * sizeof(PacoteEntrada);
+        lote.offset_quadros = (lote.offset_quadros + PACOTE_ALINHAMENTO - 1) &
+                              ~(uint64_t)(PACOTE_ALINHAMENTO - 1);
+        lote.fd_pacote = open(pacote, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (lote.fd_pacote < 0) {
+            fprintf(stderr, "ERRO: '%s': %s\n", pacote, strerror(errno));
+            return 1;
+        }
+    } else if (mkdir(lote.diretorio, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "ERRO: '%s': %s\n", lote.diretorio, strerror(errno));
+        return 1;
+    }
+
+    printf("Convertendo %d imagem(ns) com %ld thread(s)...\n", lote.total, threads);
+    double inicio = agora_segundos();
+
+    pthread_t *ids = malloc(threads * sizeof(pthread_t));
+    if (!ids) {
+        fprintf(stderr, "ERRO: Falha ao alocar as threads\n");
+        return 1;
+    }
+    for (i = 0; i < threads; i++) {
+        if (pthread_create(&ids[i], NULL, trabalhador, &lote) != 0) {
+            // Segue com as que subiram (a thread principal trabalha se nenhuma subiu)
+            threads = i;
+            break;
+        }
+    }
+    if (threads == 0) {
+        trabalhador(&lote);
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    free(ids);
+
+    int convertidas = 0;
+    for (i = 0; i < lote.total; i++) {
+        convertidas += lote.tarefas[i].convertida;
+    }
+
+    int resultado = 0;
+    if (pacote) {
+        if (finalizar_pacote(&lote, convertidas) != 0) {
+            fprintf(stderr, "ERRO: Falha ao fechar o pacote '%s': %s\n", pacote, strerror(errno));
+            resultado = 1;
+        }
+        close(lote.fd_pacote);
+    }
+
+    double segundos = agora_segundos() - inicio;
+    printf("✓ %d convertida(s), %d falha(s) em %.2f s (%.0f imagens/s)%s%s\n",
+           convertidas, lote.total - convertidas, segundos,
+           convertidas / (segundos > 0 ? segundos : 1e-9),
+           pacote ? " -> " : "", pacote ? pacote : "");
+
+    for (i = 0; i < lote.total; i++) {
+        free(lote.tarefas[i].caminho);
+    }
+    free(lote.tarefas);
+    return (resultado != 0 || convertidas != lote.total) ? 1 : 0;
+}
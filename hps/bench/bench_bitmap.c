@@ -0,0 +1,552 @@
+// ========================================================================
+// bench_bitmap.c - carregar_bitmap (mmap + luma inteira) contra a versão
+//                  anterior (fread por linha + luma em double)
+//
+// Gera BMPs 160x120 de 8 e 24 bits em /tmp (24 bits de baixo para cima e
+// de cima para baixo), carrega cada um pelas duas implementações e mede
+// o tempo médio por arquivo. Também conta os pixels em que as duas
+// conversões para cinza diferem: a versão em double trunca para baixo
+// alguns valores exatos (ex.: 0.299*R + 0.587*G + 0.114*B = 99.99999...).
+// Uma foto 1920x1080 de 24 bits mede só a redução por média de área, que
+// a versão anterior não tinha, e os demais formatos (paleta colorida, RLE8,
+// RLE4, 16 bits, 32 bits BGRA e BI_BITFIELDS) medem a vazão de cada
+// decodificador em MPix/s: também não existiam na versão anterior.
+//
+// Antes de medir, o resultado de carregar_bitmap() é comparado com o cinza
+// que o gerador calcula dos próprios índices, paleta e pixels (e com uma
+// média de área direta na foto grande); qualquer diferença encerra com 1.
+//
+// Uso: ./bench_bitmap [iteracoes]   (padrão: 2000)
+// Compilar: make bench
+// ========================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../bitmap.h"
+
+#define LARGURA 160
+#define ALTURA 120
+#define IMG_SIZE (LARGURA * ALTURA)
+
+#define TOTAL_ARQUIVOS 11
+
+typedef struct
+{
+    const char *nome;
+    int bits;
+    int compressao;
+    uint32_t mascaras[3];   /* R, G, B em BMP_BI_BITFIELDS */
+    int largura, altura;
+    int de_cima_para_baixo;
+    int paleta;             /* 8 bits sem compressão: 1 = paleta colorida */
+    char caminho[64];
+    long bytes;
+} Arquivo;
+
+static Arquivo arquivos[TOTAL_ARQUIVOS] = {
+    {"8 bits", 8, BMP_BI_RGB, {0}, LARGURA, ALTURA, 0, 0, "", 0},
+    {"8b paleta", 8, BMP_BI_RGB, {0}, LARGURA, ALTURA, 0, 1, "", 0},
+    {"24 bits", 24, BMP_BI_RGB, {0}, LARGURA, ALTURA, 0, 0, "", 0},
+    {"24 bits topo", 24, BMP_BI_RGB, {0}, LARGURA, ALTURA, 1, 0, "", 0},
+    {"24b 1920x1080", 24, BMP_BI_RGB, {0}, 1920, 1080, 0, 0, "", 0},
+    {"RLE8", 8, BMP_BI_RLE8, {0}, LARGURA, ALTURA, 0, 0, "", 0},
+    {"RLE4", 4, BMP_BI_RLE4, {0}, LARGURA, ALTURA, 0, 0, "", 0},
+    {"16b 5-5-5", 16, BMP_BI_RGB, {0}, LARGURA, ALTURA, 0, 0, "", 0},
+    {"16b 5-6-5", 16, BMP_BI_BITFIELDS, {0xF800, 0x07E0, 0x001F}, LARGURA, ALTURA, 0, 0, "", 0},
+    {"32b BGRA", 32, BMP_BI_RGB, {0}, LARGURA, ALTURA, 0, 0, "", 0},
+    {"32b 10-10-10", 32, BMP_BI_BITFIELDS, {0x3FF00000, 0x000FFC00, 0x000003FF},
+     LARGURA, ALTURA, 0, 0, "", 0},
+};
+
+static double agora_segundos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Implementação anterior de carregar_bitmap(), mantida como referência */
+static int carregar_bitmap_fread(const char *nome_arquivo, unsigned char *buffer,
+                                 int largura_esperada, int altura_esperada)
+{
+    FILE *arquivo = fopen(nome_arquivo, "rb");
+    BMPHeader header;
+    BMPInfoHeader info;
+    int bytes_pixel, tamanho_linha, altura_abs, invertido, x, y;
+    unsigned char *linha;
+
+    if (!arquivo)
+        return -1;
+    if (fread(&header, sizeof(header), 1, arquivo) != 1 ||
+        fread(&info, sizeof(info), 1, arquivo) != 1 || header.tipo != 0x4D42)
+    {
+        fclose(arquivo);
+        return -1;
+    }
+    printf("  ├─ Dimensões: %dx%d pixels\n", info.largura, abs(info.altura));
+    printf("  ├─ Bits por pixel: %d\n", info.bits_por_pixel);
+    printf("  └─ Compressão: %d\n", info.compressao);
+    if (info.largura != largura_esperada || abs(info.altura) != altura_esperada ||
+        (info.bits_por_pixel != 8 && info.bits_por_pixel != 24))
+    {
+        fclose(arquivo);
+        return -1;
+    }
+
+    bytes_pixel = info.bits_por_pixel / 8;
+    tamanho_linha = (largura_esperada * bytes_pixel + 3) & ~3;
+    altura_abs = abs(info.altura);
+    invertido = (info.altura > 0);
+    fseek(arquivo, header.offset, SEEK_SET);
+
+    linha = (unsigned char *)malloc(tamanho_linha);
+    if (!linha)
+    {
+        fclose(arquivo);
+        return -1;
+    }
+
+    for (y = 0; y < altura_abs; y++)
+    {
+        unsigned char *destino = &buffer[(invertido ? altura_abs - 1 - y : y) * largura_esperada];
+        if (fread(linha, 1, tamanho_linha, arquivo) != (size_t)tamanho_linha)
+        {
+            free(linha);
+            fclose(arquivo);
+            return -1;
+        }
+        if (bytes_pixel == 1)
+        {
+            memcpy(destino, linha, largura_esperada);
+            continue;
+        }
+        for (x = 0; x < largura_esperada; x++)
+        {
+            unsigned char b = linha[x * 3], g = linha[x * 3 + 1], r = linha[x * 3 + 2];
+            destino[x] = (unsigned char)(0.299 * r + 0.587 * g + 0.114 * b);
+        }
+    }
+
+    free(linha);
+    fclose(arquivo);
+    printf("  └─ Arquivo carregado com sucesso!\n");
+    return 0;
+}
+
+static unsigned int semente;
+
+static unsigned int aleatorio(void)
+{
+    semente = semente * 1103515245u + 12345u;
+    return semente >> 16;
+}
+
+/* Cinza de referência: a mesma luma inteira de bitmap.c, sem vetorização */
+static unsigned char luma_referencia(unsigned int r, unsigned int g, unsigned int b)
+{
+    return (unsigned char)((299 * r + 587 * g + 114 * b) / 1000);
+}
+
+/* Canal descrito por uma máscara, levado a 0..255 com arredondamento.
+ * Canais com mais de 8 bits valem pelos 8 mais significativos */
+static unsigned int canal_referencia(uint32_t pixel, uint32_t mascara)
+{
+    unsigned int bits = 0, maximo;
+
+    if (mascara == 0)
+        return 0;
+    while (!(mascara & 1))
+    {
+        mascara >>= 1;
+        pixel >>= 1;
+    }
+    while (mascara >> bits)
+        bits++;
+    pixel &= mascara;
+    if (bits > 8)
+    {
+        pixel >>= bits - 8;
+        bits = 8;
+    }
+    maximo = (1u << bits) - 1;
+    return (pixel * 255 + maximo / 2) / maximo;
+}
+
+/* Média de área direta: cada pixel da fonte entra com a área, em unidades
+ * de 1/(saída) pixel, que divide com o pixel da saída */
+static void reduzir_referencia(const unsigned char *cinza, int largura, int altura,
+                               unsigned char *saida, int largura_saida, int altura_saida)
+{
+    unsigned long long total = (unsigned long long)largura * altura;
+    int x, y, fx, fy;
+
+    for (y = 0; y < altura_saida; y++)
+    {
+        long inicio_y = (long)y * altura, fim_y = inicio_y + altura;
+        for (x = 0; x < largura_saida; x++)
+        {
+            long inicio_x = (long)x * largura, fim_x = inicio_x + largura;
+            unsigned long long soma = 0;
+            for (fy = inicio_y / altura_saida; fy * (long)altura_saida < fim_y; fy++)
+            {
+                long a = fy * (long)altura_saida, b = a + altura_saida;
+                unsigned long long peso_y = (b < fim_y ? b : fim_y) - (a > inicio_y ? a : inicio_y);
+                for (fx = inicio_x / largura_saida; fx * (long)largura_saida < fim_x; fx++)
+                {
+                    long c = fx * (long)largura_saida, d = c + largura_saida;
+                    unsigned long long peso_x = (d < fim_x ? d : fim_x) - (c > inicio_x ? c : inicio_x);
+                    soma += peso_y * peso_x * cinza[fy * largura + fx];
+                }
+            }
+            saida[y * largura_saida + x] = (unsigned char)((soma + total / 2) / total);
+        }
+    }
+}
+
+/* Headers, máscaras ou paleta e os dados já codificados */
+static int escrever_bmp(const Arquivo *arq, const void *extra, int bytes_extra,
+                        const unsigned char *dados, int bytes_dados)
+{
+    BMPHeader header = {0};
+    BMPInfoHeader info = {0};
+    FILE *arquivo = fopen(arq->caminho, "wb");
+
+    if (!arquivo)
+        return -1;
+    header.tipo = 0x4D42;
+    header.offset = sizeof(BMPHeader) + sizeof(BMPInfoHeader) + bytes_extra;
+    header.tamanho = header.offset + bytes_dados;
+    info.tamanho = sizeof(BMPInfoHeader);
+    info.largura = arq->largura;
+    info.altura = arq->de_cima_para_baixo ? -arq->altura : arq->altura;
+    info.planos = 1;
+    info.bits_por_pixel = arq->bits;
+    info.compressao = arq->compressao;
+    info.tamanho_imagem = bytes_dados;
+    fwrite(&header, sizeof(header), 1, arquivo);
+    fwrite(&info, sizeof(info), 1, arquivo);
+    fwrite(extra, 1, bytes_extra, arquivo);
+    fwrite(dados, 1, bytes_dados, arquivo);
+    fclose(arquivo);
+    return 0;
+}
+
+/* BMP de 8 bits com paleta colorida, ou de 16, 24 ou 32 bits sem compressão
+ * ou com máscaras, pixels pseudoaleatórios. Em cinza fica o resultado
+ * esperado, de cima para baixo */
+static int gerar_bmp_pixels(const Arquivo *arq, unsigned char *cinza)
+{
+    int bytes_pixel = arq->bits / 8;
+    int tamanho_linha = (arq->largura * bytes_pixel + 3) & ~3;
+    int bytes = tamanho_linha * arq->altura;
+    unsigned char *dados = (unsigned char *)calloc(bytes, 1);
+    unsigned char paleta[256 * 4];
+    uint32_t mascaras[3] = {0xFF0000, 0x00FF00, 0x0000FF};
+    int x, y, i, resultado;
+
+    if (!dados)
+        return -1;
+    if (arq->compressao == BMP_BI_BITFIELDS)
+        memcpy(mascaras, arq->mascaras, sizeof(mascaras));
+    else if (arq->bits == 16)
+    {
+        mascaras[0] = 0x7C00;
+        mascaras[1] = 0x03E0;
+        mascaras[2] = 0x001F;
+    }
+
+    semente = 12345;
+    if (arq->bits == 8)
+    {
+        for (i = 0; i < 256 * 4; i++)
+            paleta[i] = (i % 4 == 3) ? 0 : (unsigned char)aleatorio();
+    }
+    for (y = 0; y < arq->altura; y++)
+    {
+        unsigned char *linha = &dados[y * tamanho_linha];
+        unsigned char *esperado =
+            &cinza[(arq->de_cima_para_baixo ? y : arq->altura - 1 - y) * arq->largura];
+        for (x = 0; x < arq->largura * bytes_pixel; x++)
+        {
+            linha[x] = (unsigned char)aleatorio();
+        }
+        for (x = 0; x < arq->largura; x++)
+        {
+            const unsigned char *p = &linha[x * bytes_pixel];
+            uint32_t pixel = 0;
+            if (arq->bits == 8)
+            {
+                esperado[x] = luma_referencia(paleta[p[0] * 4 + 2], paleta[p[0] * 4 + 1],
+                                              paleta[p[0] * 4]);
+                continue;
+            }
+            for (i = 0; i < bytes_pixel; i++)
+                pixel |= (uint32_t)p[i] << (8 * i);
+            esperado[x] = luma_referencia(canal_referencia(pixel, mascaras[0]),
+                                          canal_referencia(pixel, mascaras[1]),
+                                          canal_referencia(pixel, mascaras[2]));
+        }
+    }
+    if (arq->bits == 8)
+        resultado = escrever_bmp(arq, paleta, sizeof(paleta), dados, bytes);
+    else
+        resultado = escrever_bmp(arq, arq->mascaras,
+                                 arq->compressao == BMP_BI_BITFIELDS ? sizeof(arq->mascaras) : 0,
+                                 dados, bytes);
+    free(dados);
+    return resultado;
+}
+
+/* BMP RLE8/RLE4 de faixas horizontais de 1 a 24 pixels com índices
+ * pseudoaleatórios: faixas de 3 ou mais pixels viram trechos codificados,
+ * as mais curtas se juntam em trechos absolutos. Em cinza fica o resultado
+ * esperado, de cima para baixo */
+static int gerar_bmp_rle(const Arquivo *arq, unsigned char *cinza)
+{
+    int rle4 = (arq->compressao == BMP_BI_RLE4);
+    int cores = 1 << arq->bits;
+    unsigned char paleta[256 * 4];
+    unsigned char *linha = (unsigned char *)malloc(arq->largura);
+    unsigned char *dados = (unsigned char *)malloc(arq->altura * (arq->largura * 2 + 2) + 2);
+    int n = 0, x, y, i, resultado;
+
+    if (!linha || !dados)
+    {
+        free(linha);
+        free(dados);
+        return -1;
+    }
+    semente = 12345;
+    for (i = 0; i < cores * 4; i++)
+    {
+        paleta[i] = (i % 4 == 3) ? 0 : (unsigned char)aleatorio();
+    }
+
+    for (y = 0; y < arq->altura; y++)
+    {
+        for (x = 0; x < arq->largura;)
+        {
+            int faixa = 1 + aleatorio() % 24;
+            unsigned char indice = (unsigned char)(aleatorio() % cores);
+            for (i = 0; i < faixa && x < arq->largura; i++)
+                linha[x++] = indice;
+        }
+        for (x = 0; x < arq->largura; x++)
+        {
+            cinza[(arq->altura - 1 - y) * arq->largura + x] =
+                luma_referencia(paleta[linha[x] * 4 + 2], paleta[linha[x] * 4 + 1],
+                                paleta[linha[x] * 4]);
+        }
+
+        for (x = 0; x < arq->largura;)
+        {
+            int fim = x + 1;
+            while (fim < arq->largura && fim - x < 255 && linha[fim] == linha[x])
+                fim++;
+            if (fim - x >= 3)
+            {
+                dados[n++] = (unsigned char)(fim - x);
+                dados[n++] = rle4 ? (unsigned char)(linha[x] << 4 | linha[x]) : linha[x];
+                x = fim;
+                continue;
+            }
+
+            /* Absoluto até a próxima faixa de 3 (mínimo de 3 pixels) */
+            fim = x;
+            while (fim < arq->largura && fim - x < 255 &&
+                   (fim - x < 3 || fim + 2 >= arq->largura ||
+                    linha[fim] != linha[fim + 1] || linha[fim] != linha[fim + 2]))
+                fim++;
+            if (fim - x < 3)
+            {
+                /* Sobra curta no fim da linha: um trecho por pixel */
+                for (; x < fim; x++)
+                {
+                    dados[n++] = 1;
+                    dados[n++] = rle4 ? (unsigned char)(linha[x] << 4) : linha[x];
+                }
+                continue;
+            }
+            dados[n++] = 0;
+            dados[n++] = (unsigned char)(fim - x);
+            for (i = 0; x + i < fim; i += rle4 ? 2 : 1)
+            {
+                if (!rle4)
+                    dados[n++] = linha[x + i];
+                else
+                    dados[n++] = (unsigned char)(linha[x + i] << 4 |
+                                                 (x + i + 1 < fim ? linha[x + i + 1] : 0));
+            }
+            if (n & 1)
+                dados[n++] = 0;
+            x = fim;
+        }
+        dados[n++] = 0;
+        dados[n++] = (y == arq->altura - 1) ? 1 : 0;
+    }
+
+    resultado = escrever_bmp(arq, paleta, cores * 4, dados, n);
+    free(linha);
+    free(dados);
+    return resultado;
+}
+
+/* Tempo médio de um carregamento, em microssegundos */
+static double medir(int (*carregar)(const char *, unsigned char *, int, int),
+                    const char *caminho, unsigned char *buffer, int iteracoes)
+{
+    double inicio = agora_segundos();
+    int i;
+    for (i = 0; i < iteracoes; i++)
+    {
+        carregar(caminho, buffer, LARGURA, ALTURA);
+    }
+    return (agora_segundos() - inicio) * 1e6 / iteracoes;
+}
+
+int main(int argc, char **argv)
+{
+    static unsigned char imagem[IMG_SIZE];
+    static unsigned char antigo[IMG_SIZE];
+    static unsigned char novo[IMG_SIZE];
+    static unsigned char esperado[IMG_SIZE];
+    double tempo_antigo[TOTAL_ARQUIVOS], tempo_novo[TOTAL_ARQUIVOS];
+    int diferentes[TOTAL_ARQUIVOS];
+    double mpix[TOTAL_ARQUIVOS];
+    int iteracoes = (argc > 1) ? atoi(argv[1]) : 2000;
+    int saida, nulo, i, a;
+
+    if (iteracoes <= 0)
+    {
+        fprintf(stderr, "Uso: %s [iteracoes]\n", argv[0]);
+        return 1;
+    }
+
+    for (i = 0; i < IMG_SIZE; i++)
+    {
+        imagem[i] = (unsigned char)(i * 31);
+    }
+
+    /* As duas implementações imprimem o header: cala o stdout durante as medidas */
+    fflush(stdout);
+    saida = dup(STDOUT_FILENO);
+    nulo = open("/dev/null", O_WRONLY);
+    dup2(nulo, STDOUT_FILENO);
+
+    for (a = 0; a < TOTAL_ARQUIVOS; a++)
+    {
+        Arquivo *arq = &arquivos[a];
+        int mesmo_tamanho = (arq->largura == LARGURA && arq->altura == ALTURA);
+        unsigned char *cinza = (unsigned char *)malloc((size_t)arq->largura * arq->altura);
+        int erradas = 0;
+        FILE *gerado;
+
+        if (!cinza)
+        {
+            fflush(stdout);
+            dup2(saida, STDOUT_FILENO);
+            fprintf(stderr, "ERRO: sem memória para %s\n", arq->nome);
+            return 1;
+        }
+        snprintf(arq->caminho, sizeof(arq->caminho), "/tmp/bench_bitmap_%d.bmp", a);
+        if (arq->compressao == BMP_BI_RLE8 || arq->compressao == BMP_BI_RLE4)
+            gerar_bmp_rle(arq, cinza);
+        else if (arq->bits == 8 && !arq->paleta)
+        {
+            salvar_bitmap(arq->caminho, imagem, LARGURA, ALTURA);
+            memcpy(cinza, imagem, IMG_SIZE);
+        }
+        else
+            gerar_bmp_pixels(arq, cinza);
+
+        /* A foto grande é reduzida por uma média de área direta */
+        if (mesmo_tamanho)
+            memcpy(esperado, cinza, IMG_SIZE);
+        else
+            reduzir_referencia(cinza, arq->largura, arq->altura, esperado, LARGURA, ALTURA);
+        free(cinza);
+
+        arq->bytes = 0;
+        gerado = fopen(arq->caminho, "rb");
+        if (gerado)
+        {
+            fseek(gerado, 0, SEEK_END);
+            arq->bytes = ftell(gerado);
+            fclose(gerado);
+        }
+
+        /* A versão anterior só lia 160x120 de 8 ou 24 bits sem compressão,
+         * e em 8 bits ignorava a paleta */
+        mesmo_tamanho = mesmo_tamanho && arq->compressao == BMP_BI_RGB &&
+                        ((arq->bits == 8 && !arq->paleta) || arq->bits == 24);
+        if ((mesmo_tamanho &&
+             carregar_bitmap_fread(arq->caminho, antigo, LARGURA, ALTURA) != 0) ||
+            carregar_bitmap(arq->caminho, novo, LARGURA, ALTURA) != 0)
+        {
+            fflush(stdout);
+            dup2(saida, STDOUT_FILENO);
+            fprintf(stderr, "ERRO: falha ao carregar %s\n", arq->caminho);
+            return 1;
+        }
+        if (memcmp(novo, esperado, IMG_SIZE) != 0)
+        {
+            for (i = 0; i < IMG_SIZE; i++)
+            {
+                erradas += novo[i] != esperado[i];
+            }
+            for (i = 0; novo[i] == esperado[i]; i++)
+                ;
+            fflush(stdout);
+            dup2(saida, STDOUT_FILENO);
+            fprintf(stderr, "ERRO: %s: %d pixels diferentes da referência, "
+                    "primeiro em %d,%d (%d, esperado %d)\n", arq->nome, erradas,
+                    i % LARGURA, i / LARGURA, novo[i], esperado[i]);
+            unlink(arq->caminho);
+            return 1;
+        }
+        diferentes[a] = 0;
+        tempo_antigo[a] = 0.0;
+        if (mesmo_tamanho)
+        {
+            for (i = 0; i < IMG_SIZE; i++)
+            {
+                diferentes[a] += antigo[i] != novo[i];
+            }
+            tempo_antigo[a] = medir(carregar_bitmap_fread, arq->caminho, antigo, iteracoes);
+        }
+        /* A foto grande custa ~1000x mais por carga: menos iterações */
+        tempo_novo[a] = medir(carregar_bitmap, arq->caminho, novo,
+                              arq->largura == LARGURA ? iteracoes : (iteracoes + 99) / 100);
+        mpix[a] = (double)arq->largura * arq->altura / tempo_novo[a];
+        unlink(arq->caminho);
+    }
+
+    fflush(stdout);
+    dup2(saida, STDOUT_FILENO);
+    close(nulo);
+    close(saida);
+
+    printf("BMP %dx%d, %d iterações por medida\n\n", LARGURA, ALTURA, iteracoes);
+    printf("%-14s %9s %14s %14s %8s %8s %12s\n",
+           "Arquivo", "Bytes", "fread+double", "mmap+inteiro", "MPix/s", "Ganho", "Pixels dif.");
+    printf("------------------------------------------------------------------"
+           "-------------------\n");
+    for (a = 0; a < TOTAL_ARQUIVOS; a++)
+    {
+        if (tempo_antigo[a] == 0.0)
+        {
+            printf("%-14s %9ld %14s %11.1f us %8.1f %8s %12s\n", arquivos[a].nome,
+                   arquivos[a].bytes, "-", tempo_novo[a], mpix[a], "-", "-");
+            continue;
+        }
+        printf("%-14s %9ld %11.1f us %11.1f us %8.1f %7.2fx %12d\n", arquivos[a].nome,
+               arquivos[a].bytes, tempo_antigo[a], tempo_novo[a], mpix[a],
+               tempo_antigo[a] / tempo_novo[a], diferentes[a]);
+    }
+    printf("\nTodos os formatos iguais à referência\n");
+    return 0;
+}
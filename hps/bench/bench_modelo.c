@@ -0,0 +1,170 @@
+// ========================================================================
+// bench_modelo.c - Modelo da ALU na CPU contra os ciclos da FPGA
+//
+// Executa cada opcode de alu_modelo.c com os laços escalares e com os
+// vetoriais (SSE2/NEON), confere que os dois deixam o mesmo framebuffer
+// e compara o tempo por quadro na CPU com o da ALU a 25 MHz.
+//
+// Com BACKEND=hw cada opcode também roda na FPGA e a coluna "FPGA us" vem
+// dos ciclos medidos (coprocessador_ler_contadores, como em bench_opcodes).
+// Nos outros backends não usa a ponte e roda em qualquer máquina; a
+// coluna vira "Modelo us", os ciclos previstos por alu_modelo_ciclos().
+//
+// Uso: ./bench_modelo [iteracoes]   (padrão: 2000; sudo com BACKEND=hw)
+// Compilar: make bench BACKEND=hw|ponte|modelo
+// ========================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../alu_modelo.h"
+#ifdef BENCH_MODELO_FPGA
+#include "../coprocessador.h"
+#endif
+
+#define IMG_SIZE (160 * 120)
+#define FB_SIZE (640 * 480)
+#define CLK_ALU_HZ 25000000.0
+#define TIMEOUT_US 1000000
+
+#ifdef BENCH_MODELO_FPGA
+#define COLUNA_ALU "FPGA us"
+#define COLUNA_RAZAO "FPGA/SIMD"
+#else
+#define COLUNA_ALU "Modelo us"
+#define COLUNA_RAZAO "Mod./SIMD"
+#endif
+
+typedef struct
+{
+    const char *nome;
+    int opcode;
+} Opcode;
+
+static const Opcode opcodes[] = {
+    {"bypass", 0},
+    {"media 0.5x", 11},
+    {"media 0.25x", 12},
+    {"vizinho 2x", 17},
+    {"vizinho 4x", 18},
+    {"vizinho 0.5x", 27},
+    {"vizinho 0.25x", 28},
+    {"replicacao 2x", 33},
+    {"replicacao 4x", 34},
+};
+
+static double agora_segundos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Tempo médio de um quadro, em microssegundos */
+static double medir(int opcode, const unsigned char *rom, unsigned char *fb, int iteracoes)
+{
+    double inicio = agora_segundos();
+    int i;
+    for (i = 0; i < iteracoes; i++)
+    {
+        alu_modelo_executar(opcode, 0x10000, 0x10000, 0, rom, fb);
+    }
+    return (agora_segundos() - inicio) * 1e6 / iteracoes;
+}
+
+/* Ciclos de clk25 da operação: medidos na FPGA ou previstos pelo modelo.
+ * Retorna -1 se a FPGA não concluir */
+static double ciclos_alu(int opcode)
+{
+#ifdef BENCH_MODELO_FPGA
+    ContadoresCoprocessador contadores;
+
+    processar_imagem(opcode);
+    if (aguardar_conclusao(TIMEOUT_US) != 0)
+        return -1.0;
+    coprocessador_ler_contadores(&contadores);
+    return contadores.ciclos;
+#else
+    return alu_modelo_ciclos(opcode, 0x10000, 0x10000, 0);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    static unsigned char rom[IMG_SIZE];
+    static unsigned char fb_escalar[FB_SIZE];
+    static unsigned char fb_simd[FB_SIZE];
+    int iteracoes = (argc > 1) ? atoi(argv[1]) : 2000;
+    int i, divergencias = 0;
+    const char *variante;
+
+    if (iteracoes <= 0)
+    {
+        fprintf(stderr, "Uso: %s [iteracoes]\n", argv[0]);
+        return 1;
+    }
+
+    for (i = 0; i < IMG_SIZE; i++)
+    {
+        rom[i] = (unsigned char)(i * 31);
+    }
+
+#ifdef BENCH_MODELO_FPGA
+    /* Mesma imagem na ROM; a ROI da execução anterior fica no PIO */
+    iniciar_coprocessador();
+    carregar_imagem(rom, IMG_SIZE);
+    coprocessador_roi(0, 0, 0, 0);
+#endif
+
+    variante = alu_modelo_variante(1);
+    printf("Variante vetorial: %s, %d iterações\n\n", variante, iteracoes);
+    printf("%-15s %6s %10s %12s %12s %9s %8s\n",
+           "Operação", "Opcode", COLUNA_ALU, "Escalar us", "SIMD us", COLUNA_RAZAO, "Igual");
+    printf("----------------------------------------------------------------"
+           "------------\n");
+
+    for (i = 0; i < (int)(sizeof(opcodes) / sizeof(opcodes[0])); i++)
+    {
+        int opcode = opcodes[i].opcode;
+        double ciclos = ciclos_alu(opcode);
+        double fpga = ciclos * 1e6 / CLK_ALU_HZ;
+        double escalar, simd;
+        int igual;
+
+        if (ciclos < 0)
+        {
+            printf("%-15s %6d %10s\n", opcodes[i].nome, opcode, "timeout");
+            continue;
+        }
+
+        /* Mesmo conteúdo inicial: as bordas fora da área também são comparadas */
+        memset(fb_escalar, 0xA5, FB_SIZE);
+        memset(fb_simd, 0xA5, FB_SIZE);
+
+        alu_modelo_variante(0);
+        escalar = medir(opcode, rom, fb_escalar, iteracoes);
+        alu_modelo_variante(1);
+        simd = medir(opcode, rom, fb_simd, iteracoes);
+
+        igual = memcmp(fb_escalar, fb_simd, FB_SIZE) == 0;
+        if (!igual)
+            divergencias++;
+
+        printf("%-15s %6d %10.1f %12.1f %12.1f %8.2fx %8s\n",
+               opcodes[i].nome, opcode, fpga, escalar, simd, fpga / simd,
+               igual ? "sim" : "NAO");
+    }
+
+#ifdef BENCH_MODELO_FPGA
+    encerrar_coprocessador();
+#endif
+
+    if (divergencias)
+    {
+        fprintf(stderr, "\nERRO: %d opcode(s) com framebuffer diferente entre as variantes\n",
+                divergencias);
+        return 1;
+    }
+    return 0;
+}
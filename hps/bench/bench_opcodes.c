@@ -0,0 +1,101 @@
+// ========================================================================
+// bench_opcodes.c - Ciclos de clk25 de cada opcode da ALU
+//
+// Dispara cada api_* sobre uma imagem de teste e lê o banco de contadores
+// da FPGA (coprocessador_ler_contadores): total da operação, fase de
+// limpeza, pixels lidos da ROM e escritos no framebuffer, e latência do
+// start ao done. O tempo em ms é o dos ciclos a 25 MHz, sem a ponte.
+//
+// Uso: sudo ./bench_opcodes
+// Compilar: make bench BACKEND=hw|modelo
+// ========================================================================
+
+#include <stdio.h>
+#include "../coprocessador.h"
+
+#define IMG_SIZE (160 * 120)
+#define CLK_ALU_HZ 25000000.0
+#define TIMEOUT_US 1000000
+
+typedef struct
+{
+    const char *nome;
+    int opcode;
+    void (*executar)(void);
+} Opcode;
+
+/* Escala DDA nos fatores que não têm opcode próprio */
+static void escala_0_75x(void) { api_escala(PASSO_ESCALA(0.75), PASSO_ESCALA(0.75)); }
+static void escala_1_5x(void)  { api_escala(PASSO_ESCALA(1.5), PASSO_ESCALA(1.5)); }
+static void escala_3x(void)    { api_escala(PASSO_ESCALA(3.0), PASSO_ESCALA(3.0)); }
+
+/* Região de interesse 40x30 ampliada até a área de 160x120 */
+static void roi_vizinho_4x(void)
+{
+    coprocessador_roi(60, 45, 40, 30);
+    api_vizinho_4x();
+    coprocessador_roi(0, 0, 0, 0);
+}
+
+static const Opcode opcodes[] = {
+    {"bypass", 0, api_bypass},
+    {"media 0.5x", 11, api_media_0_5x},
+    {"media 0.25x", 12, api_media_0_25x},
+    {"vizinho 2x", 17, api_vizinho_2x},
+    {"vizinho 4x", 18, api_vizinho_4x},
+    {"vizinho 0.5x", 27, api_vizinho_0_5x},
+    {"vizinho 0.25x", 28, api_vizinho_0_25x},
+    {"replicacao 2x", 33, api_replicacao_2x},
+    {"replicacao 4x", 34, api_replicacao_4x},
+    {"bilinear 2x", 41, api_bilinear_2x},
+    {"bilinear 4x", 42, api_bilinear_4x},
+    {"escala 0.75x", 48, escala_0_75x},
+    {"escala 1.5x", 48, escala_1_5x},
+    {"escala 3x", 48, escala_3x},
+    {"roi 40x30 4x", 18, roi_vizinho_4x},
+};
+
+int main(void)
+{
+    static unsigned char imagem[IMG_SIZE];
+    ContadoresCoprocessador contadores;
+    int i;
+
+    for (i = 0; i < IMG_SIZE; i++)
+    {
+        imagem[i] = (unsigned char)(i * 31);
+    }
+
+    iniciar_coprocessador();
+    carregar_imagem(imagem, IMG_SIZE);
+
+    printf("%-15s %6s %10s %10s %10s %8s %8s %10s %8s\n",
+           "Operação", "Opcode", "Total", "Limpeza", "Desenho",
+           "ROM", "FB", "Latência", "ms");
+    printf("----------------------------------------------------------------"
+           "----------------------------\n");
+
+    for (i = 0; i < (int)(sizeof(opcodes) / sizeof(opcodes[0])); i++)
+    {
+        opcodes[i].executar();
+        if (aguardar_conclusao(TIMEOUT_US) != 0)
+        {
+            printf("%-15s %6d %10s\n", opcodes[i].nome, opcodes[i].opcode, "timeout");
+            continue;
+        }
+
+        coprocessador_ler_contadores(&contadores);
+        printf("%-15s %6d %10u %10u %10u %8u %8u %10u %8.2f\n",
+               opcodes[i].nome, opcodes[i].opcode, contadores.ciclos,
+               contadores.ciclos_limpeza, contadores.ciclos - contadores.ciclos_limpeza,
+               contadores.leituras_rom, contadores.escritas_fb, contadores.latencia,
+               contadores.ciclos * 1000.0 / CLK_ALU_HZ);
+    }
+
+    coprocessador_ler_contadores(&contadores);
+    printf("\nOperações concluídas: %u, abortadas: %u\n",
+           contadores.concluidas, contadores.abortadas);
+
+    encerrar_coprocessador();
+    return 0;
+}
@@ -7,36 +7,595 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Conversão vetorial de 24/32 bits: SSE2 no PC, NEON na placa (gcc -mfpu=neon) */
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define BITMAP_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BITMAP_NEON
+#endif
+
+// ========================================================================
+// CONVERSÃO RGB -> CINZA
+// Y = floor((299*R + 587*G + 114*B) / 1000), só com inteiros. Os laços
+// vetoriais dividem em duas etapas exatas para caber em 16 bits:
+// floor(N / 1000) = floor(floor(N / 8) / 125), e x / 125 = (x * 33555) >> 22
+// para todo x <= 31875 (255000 / 8).
+// ========================================================================
+
+#define LUMA_R 299
+#define LUMA_G 587
+#define LUMA_B 114
+#define LUMA_DIV125 33555
+
+static inline unsigned char luma(unsigned char r, unsigned char g, unsigned char b) {
+    return (unsigned char)((LUMA_R * r + LUMA_G * g + LUMA_B * b) / 1000);
+}
+
+#if defined(BITMAP_SSE2)
+/* Quatro pixels BGR dos 12 bytes baixos de v -> um pixel por lane de 32 bits
+ * (bytes 0..2 = B, G, R; o byte 3 é do próximo pixel) */
+static inline __m128i separar_bgr_sse2(__m128i v) {
+    __m128i p01 = _mm_unpacklo_epi32(v, _mm_srli_si128(v, 3));
+    __m128i p23 = _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9));
+    return _mm_unpacklo_epi64(p01, p23);
+}
+
+/* Quatro pixels com B, G, R nos bytes 0..2 de cada lane -> N/8 em 32 bits */
+static inline __m128i luma_4px_sse2(__m128i px) {
+    // B e R nas metades de 16 bits, G sozinho: madd soma os pares
+    __m128i br = _mm_and_si128(px, _mm_set1_epi32(0x00FF00FF));
+    __m128i g = _mm_and_si128(_mm_srli_epi32(px, 8), _mm_set1_epi32(0x000000FF));
+    __m128i n = _mm_add_epi32(_mm_madd_epi16(br, _mm_set1_epi32((LUMA_R << 16) | LUMA_B)),
+                              _mm_madd_epi16(g, _mm_set1_epi32(LUMA_G)));
+    return _mm_srli_epi32(n, 3);
+}
+
+/* N/8 de 8 pixels (a = 0..3, b = 4..7) -> 8 cinzas em destino */
+static inline void gravar_8px_sse2(__m128i a, __m128i b, unsigned char *destino) {
+    __m128i q = _mm_mulhi_epu16(_mm_packs_epi32(a, b), _mm_set1_epi16((short)LUMA_DIV125));
+    q = _mm_srli_epi16(q, 6);
+    _mm_storel_epi64((__m128i *)destino, _mm_packus_epi16(q, q));
+}
+#elif defined(BITMAP_NEON)
+/* Oito pixels em planos B, G, R -> 8 cinzas */
+static inline uint8x8_t luma_8px_neon(uint8x8_t b8, uint8x8_t g8, uint8x8_t r8) {
+    uint16x8_t b = vmovl_u8(b8);
+    uint16x8_t g = vmovl_u8(g8);
+    uint16x8_t r = vmovl_u8(r8);
+
+    uint32x4_t n0 = vmull_n_u16(vget_low_u16(r), LUMA_R);
+    uint32x4_t n1 = vmull_n_u16(vget_high_u16(r), LUMA_R);
+    n0 = vmlal_n_u16(n0, vget_low_u16(g), LUMA_G);
+    n1 = vmlal_n_u16(n1, vget_high_u16(g), LUMA_G);
+    n0 = vmlal_n_u16(n0, vget_low_u16(b), LUMA_B);
+    n1 = vmlal_n_u16(n1, vget_high_u16(b), LUMA_B);
+
+    uint16x8_t oitavos = vcombine_u16(vshrn_n_u32(n0, 3), vshrn_n_u32(n1, 3));
+    uint16x4_t q0 = vshrn_n_u32(vmull_n_u16(vget_low_u16(oitavos), LUMA_DIV125), 16);
+    uint16x4_t q1 = vshrn_n_u32(vmull_n_u16(vget_high_u16(oitavos), LUMA_DIV125), 16);
+    return vmovn_u16(vshrq_n_u16(vcombine_u16(q0, q1), 6));
+}
+#endif
+
+/* Converte uma linha BGR de 'largura' pixels em tons de cinza */
+static void converter_linha_bgr(const unsigned char *origem, unsigned char *destino,
+                                int largura) {
+    int x = 0;
+
+#if defined(BITMAP_SSE2)
+    // 8 pixels (24 bytes) por iteração, lidos em 16 + 16 bytes a partir de 0 e 12:
+    // os 4 bytes a mais ainda precisam ser pixels da linha
+    for (; (x + 8) * 3 + 4 <= largura * 3; x += 8) {
+        const unsigned char *p = &origem[x * 3];
+        __m128i a = luma_4px_sse2(separar_bgr_sse2(_mm_loadu_si128((const __m128i *)p)));
+        __m128i b = luma_4px_sse2(separar_bgr_sse2(_mm_loadu_si128((const __m128i *)(p + 12))));
+        gravar_8px_sse2(a, b, &destino[x]);
+    }
+#elif defined(BITMAP_NEON)
+    for (; x + 8 <= largura; x += 8) {
+        uint8x8x3_t bgr = vld3_u8(&origem[x * 3]);
+        vst1_u8(&destino[x], luma_8px_neon(bgr.val[0], bgr.val[1], bgr.val[2]));
+    }
+#endif
+
+    for (; x < largura; x++) {
+        destino[x] = luma(origem[x * 3 + 2], origem[x * 3 + 1], origem[x * 3]);
+    }
+}
+
+/* Converte uma linha BGRX/BGRA de 32 bits (alfa ignorado) em tons de cinza */
+static void converter_linha_bgrx(const unsigned char *origem, unsigned char *destino,
+                                 int largura) {
+    int x = 0;
+
+#if defined(BITMAP_SSE2)
+    // Já vem um pixel por lane de 32 bits
+    for (; x + 8 <= largura; x += 8) {
+        const unsigned char *p = &origem[x * 4];
+        __m128i a = luma_4px_sse2(_mm_loadu_si128((const __m128i *)p));
+        __m128i b = luma_4px_sse2(_mm_loadu_si128((const __m128i *)(p + 16)));
+        gravar_8px_sse2(a, b, &destino[x]);
+    }
+#elif defined(BITMAP_NEON)
+    for (; x + 8 <= largura; x += 8) {
+        uint8x8x4_t bgra = vld4_u8(&origem[x * 4]);
+        vst1_u8(&destino[x], luma_8px_neon(bgra.val[0], bgra.val[1], bgra.val[2]));
+    }
+#endif
+
+    for (; x < largura; x++) {
+        destino[x] = luma(origem[x * 4 + 2], origem[x * 4 + 1], origem[x * 4]);
+    }
+}
+
+/* Canal de cor de um pixel de 16/32 bits descrito por máscara (BI_BITFIELDS):
+ * (pixel >> deslocamento) & maximo indexa a escala para 0..255. Canais com
+ * mais de 8 bits usam só os 8 mais significativos */
+typedef struct {
+    unsigned int deslocamento;
+    unsigned int maximo;
+    unsigned char escala[256];
+} Canal;
+
+static void preparar_canal(Canal *canal, uint32_t mascara) {
+    unsigned int bits = 0;
+    unsigned int v;
+
+    canal->deslocamento = 0;
+    if (mascara == 0) {
+        canal->maximo = 0;
+        canal->escala[0] = 0;
+        return;
+    }
+    while (!(mascara & 1)) {
+        mascara >>= 1;
+        canal->deslocamento++;
+    }
+    while (mascara >> bits) {
+        bits++;
+    }
+    if (bits > 8) {
+        canal->deslocamento += bits - 8;
+        bits = 8;
+    }
+    canal->maximo = (1u << bits) - 1;
+    for (v = 0; v <= canal->maximo; v++) {
+        canal->escala[v] = (unsigned char)((v * 255 + canal->maximo / 2) / canal->maximo);
+    }
+}
+
+/* Converte uma linha de pixels de 16 ou 32 bits com máscaras R, G, B */
+static void converter_linha_mascaras(const unsigned char *origem, unsigned char *destino,
+                                     int largura, int bytes_pixel, const Canal canais[3]) {
+    int x;
+    for (x = 0; x < largura; x++) {
+        const unsigned char *p = &origem[x * bytes_pixel];
+        uint32_t pixel = p[0] | (uint32_t)p[1] << 8;
+        if (bytes_pixel == 4) {
+            pixel |= (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+        }
+        destino[x] = luma(canais[0].escala[(pixel >> canais[0].deslocamento) & canais[0].maximo],
+                          canais[1].escala[(pixel >> canais[1].deslocamento) & canais[1].maximo],
+                          canais[2].escala[(pixel >> canais[2].deslocamento) & canais[2].maximo]);
+    }
+}
+
+/* Troca cada índice de 8 bits pelo cinza da paleta (lut[índice]) */
+static void aplicar_paleta(const unsigned char *origem, unsigned char *destino,
+                           int largura, const unsigned char *lut) {
+    int x = 0;
+
+#if defined(BITMAP_NEON)
+    // vtbx4 consulta 32 entradas e mantém o destino para índices fora delas:
+    // 8 rodadas, descontando 32 do índice a cada uma, cobrem as 256
+    for (; x + 8 <= largura; x += 8) {
+        uint8x8_t indice = vld1_u8(&origem[x]);
+        uint8x8_t cinza = vdup_n_u8(0);
+        int k;
+        for (k = 0; k < 8; k++) {
+            uint8x8x4_t trecho;
+            trecho.val[0] = vld1_u8(&lut[k * 32]);
+            trecho.val[1] = vld1_u8(&lut[k * 32 + 8]);
+            trecho.val[2] = vld1_u8(&lut[k * 32 + 16]);
+            trecho.val[3] = vld1_u8(&lut[k * 32 + 24]);
+            cinza = vtbx4_u8(cinza, trecho, indice);
+            indice = vsub_u8(indice, vdup_n_u8(32));
+        }
+        vst1_u8(&destino[x], cinza);
+    }
+#else
+    // SSE2 não tem consulta de bytes (pshufb é SSSE3): 4 pixels por volta
+    for (; x + 4 <= largura; x += 4) {
+        destino[x] = lut[origem[x]];
+        destino[x + 1] = lut[origem[x + 1]];
+        destino[x + 2] = lut[origem[x + 2]];
+        destino[x + 3] = lut[origem[x + 3]];
+    }
+#endif
+
+    for (; x < largura; x++) {
+        destino[x] = lut[origem[x]];
+    }
+}
+
+/* Soma de n bytes: o interior dos vãos da média de área */
+static unsigned int somar_bytes(const unsigned char *p, int n) {
+    unsigned int soma = 0;
+    int i = 0;
+
+#if defined(BITMAP_SSE2)
+    __m128i acumulado = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        // psadbw contra zero: duas somas de 8 bytes em 64 bits
+        acumulado = _mm_add_epi64(acumulado,
+                                  _mm_sad_epu8(_mm_loadu_si128((const __m128i *)&p[i]),
+                                               _mm_setzero_si128()));
+    }
+    soma = (unsigned int)_mm_cvtsi128_si32(acumulado) +
+           (unsigned int)_mm_cvtsi128_si32(_mm_srli_si128(acumulado, 8));
+#elif defined(BITMAP_NEON)
+    uint32x4_t acumulado = vdupq_n_u32(0);
+    for (; i + 16 <= n; i += 16) {
+        acumulado = vpadalq_u16(acumulado, vpaddlq_u8(vld1q_u8(&p[i])));
+    }
+    uint64x2_t parcial = vpaddlq_u32(acumulado);
+    soma = (unsigned int)(vgetq_lane_u64(parcial, 0) + vgetq_lane_u64(parcial, 1));
+#endif
+
+    for (; i < n; i++) {
+        soma += p[i];
+    }
+    return soma;
+}
+
+// ========================================================================
+// DESCOMPRESSÃO RLE (BI_RLE8 / BI_RLE4)
+// O fluxo é decodificado em ordem, uma linha do arquivo por chamada. Os
+// saltos (delta) e o fim antecipado deixam os pixels pulados no índice 0.
+// ========================================================================
+
+typedef struct {
+    const unsigned char *pos;
+    const unsigned char *fim;
+    int pular_linhas;       // linhas inteiras puladas por um delta
+    int x_retomar;          // coluna onde o delta retoma a linha seguinte
+    int terminou;           // fim do bitmap (00 01) ou do arquivo
+} FluxoRLE;
+
+/* Índice i de um trecho RLE4: nibble alto primeiro */
+#define NIBBLE(byte, i) (((i) & 1) ? ((byte) & 0x0F) : ((byte) >> 4))
+
+/* Decodifica a próxima linha do arquivo em índices de paleta */
+static void decodificar_linha_rle(FluxoRLE *fluxo, unsigned char *indices,
+                                  int largura, int rle4) {
+    int x, i;
+
+    memset(indices, 0, largura);
+    if (fluxo->pular_linhas > 0) {
+        fluxo->pular_linhas--;
+        return;
+    }
+    x = fluxo->x_retomar;
+    fluxo->x_retomar = 0;
+
+    while (!fluxo->terminou) {
+        if (fluxo->fim - fluxo->pos < 2) {
+            fluxo->terminou = 1;
+            break;
+        }
+        int n = fluxo->pos[0];
+        int v = fluxo->pos[1];
+        fluxo->pos += 2;
+
+        if (n > 0) {
+            // Trecho codificado: n pixels de v (RLE4: os dois nibbles alternados)
+            for (i = 0; i < n && x < largura; i++, x++) {
+                indices[x] = rle4 ? NIBBLE(v, i) : v;
+            }
+        } else if (v == 0) {
+            return;                     // fim de linha
+        } else if (v == 1) {
+            fluxo->terminou = 1;        // fim do bitmap
+            return;
+        } else if (v == 2) {
+            if (fluxo->fim - fluxo->pos < 2) {
+                fluxo->terminou = 1;
+                break;
+            }
+            int dx = fluxo->pos[0];
+            int dy = fluxo->pos[1];
+            fluxo->pos += 2;
+            x = (x + dx < largura) ? x + dx : largura;
+            if (dy > 0) {
+                fluxo->pular_linhas = dy - 1;
+                fluxo->x_retomar = x;
+                return;
+            }
+        } else {
+            // Modo absoluto: v pixels literais, completados até 16 bits
+            int bytes = rle4 ? (v + 1) / 2 : v;
+            if (fluxo->fim - fluxo->pos < bytes) {
+                fluxo->terminou = 1;
+                break;
+            }
+            for (i = 0; i < v && x < largura; i++, x++) {
+                indices[x] = rle4 ? NIBBLE(fluxo->pos[i / 2], i) : fluxo->pos[i];
+            }
+            bytes += bytes & 1;
+            fluxo->pos = (fluxo->fim - fluxo->pos < bytes) ? fluxo->fim : fluxo->pos + bytes;
+        }
+    }
+}
+
+// ========================================================================
+// CARREGAMENTO
+// O arquivo é mapeado com mmap e as linhas são lidas no lugar. No mesmo
+// tamanho do buffer, cada linha vai direto para a saída; em outro tamanho,
+// passa pela média de área abaixo, uma linha da fonte por vez.
+// ========================================================================
+
+/* Maior largura/altura aceita: mantém pesos e somas da média em 32/64 bits */
+#define BMP_DIMENSAO_MAXIMA 32768
+
+/* Como cada linha do arquivo vira cinza */
+typedef enum {
+    FONTE_INDICES,      // 8 bits com paleta
+    FONTE_BGR,          // 24 bits
+    FONTE_BGRX,         // 32 bits B, G, R, X/A
+    FONTE_MASCARAS,     // 16/32 bits com máscaras (BI_BITFIELDS, 16 bits 5-5-5)
+    FONTE_RLE8,
+    FONTE_RLE4
+} FormatoFonte;
+
+/* Pixel array mapeado de um BMP, lido em ordem de arquivo por proxima_linha() */
+typedef struct {
+    FormatoFonte formato;
+    const unsigned char *pixels;    // primeira linha do arquivo (ou fluxo RLE)
+    size_t stride;                  // bytes por linha, com padding
+    int largura, altura;
+    int bytes_pixel;                // 1 a 4 (0 nos formatos RLE)
+    int invertido;                  // 1 = de baixo para cima (altura > 0)
+    int proxima;                    // próxima linha do arquivo a ler
+    int paleta_identidade;          // 1 = o índice de 8 bits já é o cinza
+    unsigned char paleta[256];      // índice -> cinza (8, RLE8 e RLE4)
+    Canal canais[3];                // R, G, B (FONTE_MASCARAS)
+    FluxoRLE rle;
+} ImagemFonte;
+
+/* Monta a tabela índice -> cinza a partir da paleta BGRA que segue o info
+ * header. Índices além das cores da paleta ficam pretos; sem paleta
+ * nenhuma, os índices valem como tons de cinza */
+static void ler_paleta(ImagemFonte *img, const unsigned char *arquivo, size_t tamanho,
+                       const BMPHeader *header, const BMPInfoHeader *info) {
+    size_t inicio = sizeof(BMPHeader) + (size_t)info->tamanho;
+    size_t fim = header->offset < tamanho ? header->offset : tamanho;
+    size_t cores = info->cores_usadas ? info->cores_usadas : (1u << info->bits_por_pixel);
+    size_t i;
+
+    if (cores > 256) {
+        cores = 256;
+    }
+    if (inicio > fim) {
+        cores = 0;
+    } else if (cores > (fim - inicio) / 4) {
+        cores = (fim - inicio) / 4;
+    }
+
+    img->paleta_identidade = 1;
+    for (i = 0; i < 256; i++) {
+        if (cores == 0) {
+            img->paleta[i] = (unsigned char)i;
+        } else if (i < cores) {
+            const unsigned char *cor = &arquivo[inicio + i * 4];
+            img->paleta[i] = luma(cor[2], cor[1], cor[0]);
+        } else {
+            img->paleta[i] = 0;
+        }
+        if (img->paleta[i] != i) {
+            img->paleta_identidade = 0;
+        }
+    }
+}
+
+/* 1 se as linhas do arquivo já são o cinza e podem ser lidas no lugar */
+static int le_no_lugar(const ImagemFonte *img) {
+    return img->formato == FONTE_INDICES && img->paleta_identidade;
+}
+
+/* Próxima linha do arquivo em tons de cinza. Retorna um ponteiro para o
+ * próprio mapeamento quando não há conversão, senão converte em temp
+ * (largura bytes). Os formatos RLE só podem ser lidos nessa ordem */
+static const unsigned char *proxima_linha(ImagemFonte *img, unsigned char *temp) {
+    const unsigned char *origem = img->pixels + img->proxima++ * img->stride;
+    
+    switch (img->formato) {
+    case FONTE_INDICES:
+        // Paleta em tons de cinza 0..255: os índices já são o resultado
+        if (img->paleta_identidade) {
+            return origem;
+        }
+        aplicar_paleta(origem, temp, img->largura, img->paleta);
+        return temp;
+    case FONTE_BGR:
+        converter_linha_bgr(origem, temp, img->largura);
+        return temp;
+    case FONTE_BGRX:
+        converter_linha_bgrx(origem, temp, img->largura);
+        return temp;
+    case FONTE_MASCARAS:
+        converter_linha_mascaras(origem, temp, img->largura, img->bytes_pixel, img->canais);
+        return temp;
+    default:
+        // RLE: índices decodificados no próprio temp, paleta aplicada no lugar
+        decodificar_linha_rle(&img->rle, temp, img->largura, img->formato == FONTE_RLE4);
+        aplicar_paleta(temp, temp, img->largura, img->paleta);
+        return temp;
+    }
+}
+
+/* Trecho da fonte coberto por um pixel da saída, em unidades de 1/n pixel
+ * da fonte (n = tamanho da saída): primeiro e último pixel tocados e a
+ * parte de cada um dentro do trecho. Os do meio entram com peso n inteiro */
+typedef struct {
+    int primeiro, ultimo;
+    unsigned int peso_primeiro, peso_ultimo;
+} Vao;
+
+static Vao calcular_vao(int i, int tamanho_fonte, int tamanho_saida) {
+    unsigned int inicio = (unsigned int)i * tamanho_fonte;
+    unsigned int fim = inicio + tamanho_fonte;
+    Vao vao;
+
+    vao.primeiro = inicio / tamanho_saida;
+    vao.ultimo = (fim - 1) / tamanho_saida;
+    if (vao.primeiro == vao.ultimo) {
+        vao.peso_primeiro = tamanho_fonte;
+        vao.peso_ultimo = 0;
+    } else {
+        vao.peso_primeiro = (vao.primeiro + 1) * tamanho_saida - inicio;
+        vao.peso_ultimo = fim - vao.ultimo * tamanho_saida;
+    }
+    return vao;
+}
+
+/* Redimensiona pela média de área: cada pixel da saída é a média dos
+ * pixels da fonte sob ele, ponderada pela fração coberta e arredondada.
+ * Percorre a fonte uma linha por vez, na ordem do arquivo (de baixo para
+ * cima nos BMPs invertidos); a memória extra é uma linha convertida da
+ * fonte (quando não dá para lê-la no lugar) e três vetores da largura da
+ * saída */
+static int reduzir_area(ImagemFonte *img, unsigned char *buffer,
+                        int largura_saida, int altura_saida) {
+    size_t bytes = largura_saida * (sizeof(unsigned long long) + sizeof(unsigned int) +
+                                    sizeof(Vao)) +
+                   (le_no_lugar(img) ? 0 : img->largura);
+    unsigned long long *acumulado = (unsigned long long *)malloc(bytes);
+    if (!acumulado) {
+        fprintf(stderr, "ERRO: Falha ao alocar buffers de redimensionamento\n");
+        return -1;
+    }
+    unsigned int *horizontal = (unsigned int *)&acumulado[largura_saida];
+    Vao *vaos = (Vao *)&horizontal[largura_saida];
+    unsigned char *temp = (unsigned char *)&vaos[largura_saida];
+
+    // Peso total de um pixel da saída: largura x altura da fonte
+    unsigned long long peso_total = (unsigned long long)img->largura * img->altura;
+    int linha_horizontal = -1;
+    int x, y, j, k, n;
+
+    for (x = 0; x < largura_saida; x++) {
+        vaos[x] = calcular_vao(x, img->largura, largura_saida);
+    }
+
+    // Invertido: linhas da saída e da fonte de baixo para cima, que é a
+    // ordem em que proxima_linha() as entrega
+    for (k = 0; k < altura_saida; k++) {
+        j = img->invertido ? altura_saida - 1 - k : k;
+        Vao vy = calcular_vao(j, img->altura, altura_saida);
+        memset(acumulado, 0, largura_saida * sizeof(unsigned long long));
+
+        for (n = 0; n <= vy.ultimo - vy.primeiro; n++) {
+            y = img->invertido ? vy.ultimo - n : vy.primeiro + n;
+            unsigned int peso_y = (y == vy.primeiro) ? vy.peso_primeiro :
+                                  (y == vy.ultimo)   ? vy.peso_ultimo : altura_saida;
+
+            // Linhas na divisa entre duas linhas da saída são somadas uma vez só
+            if (y != linha_horizontal) {
+                const unsigned char *linha = proxima_linha(img, temp);
+                for (x = 0; x < largura_saida; x++) {
+                    const Vao *v = &vaos[x];
+                    unsigned int soma = v->peso_primeiro * linha[v->primeiro];
+                    if (v->ultimo != v->primeiro) {
+                        soma += v->peso_ultimo * linha[v->ultimo] +
+                                largura_saida * somar_bytes(&linha[v->primeiro + 1],
+                                                            v->ultimo - v->primeiro - 1);
+                    }
+                    horizontal[x] = soma;
+                }
+                linha_horizontal = y;
+            }
+
+            for (x = 0; x < largura_saida; x++) {
+                acumulado[x] += (unsigned long long)peso_y * horizontal[x];
+            }
+        }
+
+        for (x = 0; x < largura_saida; x++) {
+            buffer[j * largura_saida + x] =
+                (unsigned char)((acumulado[x] + peso_total / 2) / peso_total);
+        }
+    }
+
+    free(acumulado);
+    return 0;
+}
+
+int redimensionar_cinza(const unsigned char *cinza, int largura, int altura,
+                        unsigned char *buffer, int largura_saida, int altura_saida) {
+    if (largura <= 0 || largura > BMP_DIMENSAO_MAXIMA ||
+        altura <= 0 || altura > BMP_DIMENSAO_MAXIMA) {
+        fprintf(stderr, "ERRO: Dimensões inválidas (%dx%d, máximo %dx%d)\n",
+                largura, altura, BMP_DIMENSAO_MAXIMA, BMP_DIMENSAO_MAXIMA);
+        return -1;
+    }
+    
+    // Mesmo caminho de um BMP de 8 bits de cima para baixo com paleta de cinza
+    ImagemFonte img;
+    memset(&img, 0, sizeof(img));
+    img.formato = FONTE_INDICES;
+    img.pixels = cinza;
+    img.stride = (size_t)largura;
+    img.largura = largura;
+    img.altura = altura;
+    img.bytes_pixel = 1;
+    img.paleta_identidade = 1;
+    return reduzir_area(&img, buffer, largura_saida, altura_saida);
+}
 
 int carregar_bitmap(const char *nome_arquivo, unsigned char *buffer,
-                    int largura_esperada, int altura_esperada) {
+                    int largura_saida, int altura_saida) {
     
-    FILE *arquivo = fopen(nome_arquivo, "rb");
-    if (!arquivo) {
+    int fd = open(nome_arquivo, O_RDONLY);
+    if (fd < 0) {
         fprintf(stderr, "ERRO: Não foi possível abrir '%s'\n", nome_arquivo);
         return -1;
     }
     
-    // Ler header principal
-    BMPHeader header;
-    if (fread(&header, sizeof(BMPHeader), 1, arquivo) != 1) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        st.st_size < (off_t)(sizeof(BMPHeader) + sizeof(BMPInfoHeader))) {
         fprintf(stderr, "ERRO: Falha ao ler header BMP\n");
-        fclose(arquivo);
+        close(fd);
         return -1;
     }
+    size_t tamanho = (size_t)st.st_size;
     
-    // Verificar assinatura "BM"
-    if (header.tipo != 0x4D42) {
-        fprintf(stderr, "ERRO: Arquivo não é BMP válido (assinatura: 0x%X)\n", header.tipo);
-        fclose(arquivo);
+    // MAP_POPULATE lê o arquivo inteiro de uma vez, sem uma falha de página por linha
+    const unsigned char *arquivo = (const unsigned char *)mmap(
+        NULL, tamanho, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (arquivo == MAP_FAILED) {
+        fprintf(stderr, "ERRO: Falha ao mapear '%s'\n", nome_arquivo);
         return -1;
     }
     
-    // Ler info header
+    // Headers copiados do mapeamento (o início do arquivo não tem alinhamento)
+    BMPHeader header;
     BMPInfoHeader info;
-    if (fread(&info, sizeof(BMPInfoHeader), 1, arquivo) != 1) {
-        fprintf(stderr, "ERRO: Falha ao ler info header BMP\n");
-        fclose(arquivo);
+    memcpy(&header, arquivo, sizeof(BMPHeader));
+    memcpy(&info, arquivo + sizeof(BMPHeader), sizeof(BMPInfoHeader));
+    
+    // Verificar assinatura "BM"
+    if (header.tipo != 0x4D42) {
+        fprintf(stderr, "ERRO: Arquivo não é BMP válido (assinatura: 0x%X)\n", header.tipo);
+        munmap((void *)arquivo, tamanho);
         return -1;
     }
     
@@ -45,101 +604,126 @@ int carregar_bitmap(const char *nome_arquivo, unsigned char *buffer,
     printf("  └─ Compressão: %d\n", info.compressao);
     
     // Verificar dimensões
-    if (info.largura != largura_esperada || abs(info.altura) != altura_esperada) {
-        fprintf(stderr, "ERRO: Dimensões incorretas. Esperado %dx%d, encontrado %dx%d\n",
-                largura_esperada, altura_esperada, info.largura, abs(info.altura));
-        fclose(arquivo);
+    if (info.largura <= 0 || info.largura > BMP_DIMENSAO_MAXIMA ||
+        info.altura == 0 || abs(info.altura) > BMP_DIMENSAO_MAXIMA) {
+        fprintf(stderr, "ERRO: Dimensões inválidas (%dx%d, máximo %dx%d)\n",
+                info.largura, abs(info.altura), BMP_DIMENSAO_MAXIMA, BMP_DIMENSAO_MAXIMA);
+        munmap((void *)arquivo, tamanho);
         return -1;
     }
     
-    // Posicionar no início dos dados
-    fseek(arquivo, header.offset, SEEK_SET);
-    
-    // BMPs são armazenados de baixo para cima, calcular padding
-    int largura_bytes = largura_esperada;
-    int padding = (4 - (largura_bytes % 4)) % 4;
-    int altura_abs = abs(info.altura);
-    int invertido = (info.altura > 0); // Se altura > 0, está de cabeça para baixo
-    
-    // Buffer temporário para linha com padding
-    unsigned char *linha = (unsigned char *)malloc(largura_bytes + padding);
-    if (!linha) {
-        fprintf(stderr, "ERRO: Falha ao alocar buffer temporário\n");
-        fclose(arquivo);
+    // Combinações aceitas de compressão e bits por pixel
+    ImagemFonte img;
+    memset(&img, 0, sizeof(img));
+    int bits = info.bits_por_pixel;
+    if (info.compressao == BMP_BI_RGB && bits == 8) {
+        img.formato = FONTE_INDICES;
+    } else if (info.compressao == BMP_BI_RGB && bits == 24) {
+        img.formato = FONTE_BGR;
+    } else if (info.compressao == BMP_BI_RGB && bits == 32) {
+        img.formato = FONTE_BGRX;
+    } else if ((info.compressao == BMP_BI_RGB || info.compressao == BMP_BI_BITFIELDS) &&
+               bits == 16) {
+        img.formato = FONTE_MASCARAS;
+    } else if (info.compressao == BMP_BI_BITFIELDS && bits == 32) {
+        img.formato = FONTE_MASCARAS;
+    } else if (info.compressao == BMP_BI_RLE8 && bits == 8) {
+        img.formato = FONTE_RLE8;
+    } else if (info.compressao == BMP_BI_RLE4 && bits == 4) {
+        img.formato = FONTE_RLE4;
+    } else {
+        fprintf(stderr, "ERRO: Formato não suportado (%d bits por pixel, compressão %u)\n", 
+                bits, info.compressao);
+        munmap((void *)arquivo, tamanho);
         return -1;
     }
     
-    // Ler imagem
-    if (info.bits_por_pixel == 8) {
-        // Imagem em escala de cinza (8 bits)
-        
-        // Pular tabela de cores se existir
-        if (info.cores_usadas > 0 || info.bits_por_pixel == 8) {
-            int tamanho_paleta = (info.cores_usadas > 0) ? info.cores_usadas : 256;
-            fseek(arquivo, sizeof(BMPHeader) + sizeof(BMPInfoHeader) + tamanho_paleta * 4, SEEK_SET);
-        }
-        
-        int y;
-        for (y = 0; y < altura_abs; y++) {
-            // BMP armazena de baixo para cima
-            int linha_destino = invertido ? (altura_abs - 1 - y) : y;
-            
-            if (fread(linha, 1, largura_bytes + padding, arquivo) != largura_bytes + padding) {
-                fprintf(stderr, "ERRO: Falha ao ler linha %d\n", y);
-                free(linha);
-                fclose(arquivo);
+    // Máscaras R, G, B: logo após o info header de 40 bytes (também dentro
+    // dos headers v4/v5); 16 bits sem compressão é 5-5-5
+    if (img.formato == FONTE_MASCARAS) {
+        uint32_t mascaras[3] = {0x7C00, 0x03E0, 0x001F};
+        if (info.compressao == BMP_BI_BITFIELDS) {
+            size_t inicio = sizeof(BMPHeader) + sizeof(BMPInfoHeader);
+            if (tamanho < inicio + sizeof(mascaras)) {
+                fprintf(stderr, "ERRO: Arquivo truncado (%zu bytes)\n", tamanho);
+                munmap((void *)arquivo, tamanho);
                 return -1;
             }
-            
-            memcpy(&buffer[linha_destino * largura_esperada], linha, largura_bytes);
+            memcpy(mascaras, arquivo + inicio, sizeof(mascaras));
         }
-        
-    } else if (info.bits_por_pixel == 24) {
-        // Imagem RGB (24 bits) - converter para escala de cinza
-        largura_bytes = largura_esperada * 3;
-        padding = (4 - (largura_bytes % 4)) % 4;
-        
-        free(linha);
-        linha = (unsigned char *)malloc(largura_bytes + padding);
-        
-        int y;
-        for (y = 0; y < altura_abs; y++) {
-            int linha_destino = invertido ? (altura_abs - 1 - y) : y;
-            
-            if (fread(linha, 1, largura_bytes + padding, arquivo) != largura_bytes + padding) {
-                fprintf(stderr, "ERRO: Falha ao ler linha %d\n", y);
-                free(linha);
-                fclose(arquivo);
-                return -1;
+        // BGRX em 32 bits: o mesmo caminho vetorial do BI_RGB
+        if (bits == 32 && mascaras[0] == 0xFF0000 && mascaras[1] == 0xFF00 &&
+            mascaras[2] == 0xFF) {
+            img.formato = FONTE_BGRX;
+        } else {
+            int c;
+            for (c = 0; c < 3; c++) {
+                preparar_canal(&img.canais[c], mascaras[c]);
             }
-            
-            // Converter RGB para escala de cinza: Y = 0.299*R + 0.587*G + 0.114*B
-            int x;
-            for (x = 0; x < largura_esperada; x++) {
-                int idx_rgb = x * 3;
-                unsigned char b = linha[idx_rgb];
-                unsigned char g = linha[idx_rgb + 1];
-                unsigned char r = linha[idx_rgb + 2];
-                
-                // Conversão para escala de cinza
-                unsigned char gray = (unsigned char)(0.299 * r + 0.587 * g + 0.114 * b);
-                buffer[linha_destino * largura_esperada + x] = gray;
+        }
+    }
+    
+    // Linhas alinhadas em 4 bytes; altura > 0 = de baixo para cima
+    img.largura = info.largura;
+    img.altura = abs(info.altura);
+    img.invertido = (info.altura > 0);
+    img.bytes_pixel = (img.formato == FONTE_RLE8 || img.formato == FONTE_RLE4) ? 0 : bits / 8;
+    img.stride = ((size_t)img.largura * img.bytes_pixel + 3) & ~(size_t)3;
+    
+    // A última linha pode vir sem o padding final. O fluxo RLE não tem
+    // tamanho fixo: vai até o fim do arquivo e o decodificador para nele.
+    // Conta em 64 bits: 32768x32768 a 32 bpp dá 2^32, que zera o size_t do HPS
+    if (header.offset > tamanho ||
+        (uint64_t)(tamanho - header.offset) <
+            (uint64_t)img.stride * (uint64_t)(img.altura - 1) +
+            (uint64_t)img.largura * (uint64_t)img.bytes_pixel) {
+        fprintf(stderr, "ERRO: Arquivo truncado (%zu bytes)\n", tamanho);
+        munmap((void *)arquivo, tamanho);
+        return -1;
+    }
+    img.pixels = arquivo + header.offset;
+    if (img.bytes_pixel == 0) {
+        // RLE de cima para baixo não existe no formato
+        if (!img.invertido) {
+            fprintf(stderr, "ERRO: BMP RLE com altura negativa\n");
+            munmap((void *)arquivo, tamanho);
+            return -1;
+        }
+        img.rle.pos = img.pixels;
+        img.rle.fim = arquivo + tamanho;
+    }
+    
+    if (bits <= 8) {
+        ler_paleta(&img, arquivo, tamanho, &header, &info);
+        if (!img.paleta_identidade) {
+            printf("  ├─ Paleta convertida para tons de cinza\n");
+        }
+    }
+    
+    int resultado = 0;
+    if (img.largura == largura_saida && img.altura == altura_saida) {
+        // Mesmo tamanho: cada linha do arquivo vai direto para sua linha no buffer
+        int f;
+        for (f = 0; f < img.altura; f++) {
+            int y = img.invertido ? img.altura - 1 - f : f;
+            unsigned char *destino = &buffer[y * largura_saida];
+            const unsigned char *linha = proxima_linha(&img, destino);
+            if (linha != destino) {
+                memcpy(destino, linha, largura_saida);
             }
         }
-        
     } else {
-        fprintf(stderr, "ERRO: Formato não suportado (%d bits por pixel)\n", 
-                info.bits_por_pixel);
-        free(linha);
-        fclose(arquivo);
-        return -1;
+        printf("  ├─ Redimensionando para %dx%d (média de área)\n",
+               largura_saida, altura_saida);
+        resultado = reduzir_area(&img, buffer, largura_saida, altura_saida);
     }
     
-    free(linha);
-    fclose(arquivo);
+    munmap((void *)arquivo, tamanho);
     
-    printf("  └─ Arquivo carregado com sucesso!\n");
-    return 0;
+    if (resultado == 0) {
+        printf("  └─ Arquivo carregado com sucesso!\n");
+    }
+    return resultado;
 }
 
 int salvar_bitmap(const char *nome_arquivo, unsigned char *buffer,
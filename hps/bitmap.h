@@ -34,17 +34,42 @@ typedef struct {
 
 #pragma pack(pop)
 
+// Valores de BMPInfoHeader.compressao
+#define BMP_BI_RGB          0
+#define BMP_BI_RLE8         1
+#define BMP_BI_RLE4         2
+#define BMP_BI_BITFIELDS    3
+
 /**
  * Carrega um arquivo BMP em escala de cinza
  * 
- * @param nome_arquivo: Caminho do arquivo BMP
+ * Imagens de outro tamanho são redimensionadas para largura_saida x
+ * altura_saida pela média de área, lendo a fonte uma linha por vez
+ * 
+ * @param nome_arquivo: Caminho do arquivo BMP (8, 16, 24 ou 32 bits, RLE8,
+ *                      RLE4 ou BI_BITFIELDS; até 32768x32768)
  * @param buffer: Buffer de saída (deve estar alocado)
- * @param largura_esperada: Largura esperada da imagem
- * @param altura_esperada: Altura esperada da imagem
+ * @param largura_saida: Largura do buffer de saída
+ * @param altura_saida: Altura do buffer de saída
  * @return 0 em sucesso, -1 em erro
  */
 int carregar_bitmap(const char *nome_arquivo, unsigned char *buffer, 
-                    int largura_esperada, int altura_esperada);
+                    int largura_saida, int altura_saida);
+
+/**
+ * Redimensiona uma imagem em tons de cinza pela mesma média de área de
+ * carregar_bitmap() (reduz ou amplia; seguro entre threads)
+ * 
+ * @param cinza: Pixels da fonte, de cima para baixo, sem padding
+ * @param largura: Largura da fonte (até 32768)
+ * @param altura: Altura da fonte (até 32768)
+ * @param buffer: Buffer de saída (largura_saida x altura_saida)
+ * @param largura_saida: Largura do buffer de saída
+ * @param altura_saida: Altura do buffer de saída
+ * @return 0 em sucesso, -1 em erro
+ */
+int redimensionar_cinza(const unsigned char *cinza, int largura, int altura,
+                        unsigned char *buffer, int largura_saida, int altura_saida);
 
 /**
  * Salva buffer em arquivo BMP (escala de cinza)
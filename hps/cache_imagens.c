@@ -0,0 +1,100 @@
+// ========================================================================
+// cache_imagens.c - Cache LRU de imagens decodificadas (ver cache_imagens.h)
+// ========================================================================
+
+#include "cache_imagens.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ALINHAMENTO_CACHE 64
+
+int criar_cache_imagens(CacheImagens *cache, size_t orcamento, size_t bytes_quadro)
+{
+    memset(cache, 0, sizeof(*cache));
+    cache->bytes_quadro = bytes_quadro;
+    cache->capacidade = (int)(orcamento / bytes_quadro);
+    if (cache->capacidade == 0)
+        return 0;
+
+    cache->entradas = (EntradaCache *)calloc(cache->capacidade, sizeof(EntradaCache));
+    cache->quadros = (unsigned char *)aligned_alloc(ALINHAMENTO_CACHE,
+                                                    cache->capacidade * bytes_quadro);
+    if (!cache->entradas || !cache->quadros)
+    {
+        destruir_cache_imagens(cache);
+        return -1;
+    }
+    return 0;
+}
+
+void destruir_cache_imagens(CacheImagens *cache)
+{
+    free(cache->entradas);
+    free(cache->quadros);
+    memset(cache, 0, sizeof(*cache));
+}
+
+static unsigned char *quadro_cache(const CacheImagens *cache, int indice)
+{
+    return cache->quadros + indice * cache->bytes_quadro;
+}
+
+/* Entrada ocupada com esse caminho (de qualquer versão do arquivo), ou -1 */
+static int entrada_do_caminho(const CacheImagens *cache, const char *caminho)
+{
+    int i;
+    for (i = 0; i < cache->capacidade; i++)
+    {
+        if (cache->entradas[i].uso && strcmp(cache->entradas[i].caminho, caminho) == 0)
+            return i;
+    }
+    return -1;
+}
+
+const unsigned char *procurar_no_cache(CacheImagens *cache, const char *caminho,
+                                       const struct stat *st)
+{
+    int i = entrada_do_caminho(cache, caminho);
+
+    if (i >= 0 && cache->entradas[i].modificacao.tv_sec == st->st_mtim.tv_sec &&
+        cache->entradas[i].modificacao.tv_nsec == st->st_mtim.tv_nsec &&
+        cache->entradas[i].tamanho == st->st_size)
+    {
+        cache->entradas[i].uso = ++cache->relogio;
+        cache->acertos++;
+        return quadro_cache(cache, i);
+    }
+    if (cache->capacidade > 0)
+        cache->faltas++;
+    return NULL;
+}
+
+unsigned char *reservar_no_cache(CacheImagens *cache, const char *caminho,
+                                 const struct stat *st)
+{
+    int i, escolhida;
+
+    if (cache->capacidade == 0 || strlen(caminho) >= CACHE_CAMINHO_MAXIMO)
+        return NULL;
+
+    // Versão antiga do mesmo arquivo, senão uma livre, senão a menos recente
+    escolhida = entrada_do_caminho(cache, caminho);
+    if (escolhida < 0)
+    {
+        escolhida = 0;
+        for (i = 1; i < cache->capacidade && cache->entradas[escolhida].uso; i++)
+        {
+            if (cache->entradas[i].uso < cache->entradas[escolhida].uso)
+                escolhida = i;
+        }
+        if (!cache->entradas[escolhida].uso)
+            cache->ocupadas++;
+    }
+
+    EntradaCache *entrada = &cache->entradas[escolhida];
+    strcpy(entrada->caminho, caminho);
+    entrada->modificacao = st->st_mtim;
+    entrada->tamanho = st->st_size;
+    entrada->uso = ++cache->relogio;
+    return quadro_cache(cache, escolhida);
+}
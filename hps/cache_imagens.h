@@ -0,0 +1,69 @@
+// ========================================================================
+// cache_imagens.h - Cache LRU de imagens 160x120 já decodificadas
+//
+// Guarda os últimos BMPs carregados, chaveados pelo caminho e pela data de
+// modificação (e tamanho) do arquivo: reabrir uma imagem que não mudou no
+// disco não lê nem decodifica nada, só devolve o quadro guardado. Todos os
+// quadros vêm de um bloco alocado uma única vez em criar_cache_imagens(),
+// do tamanho do orçamento de memória; quando ele enche, a entrada usada há
+// mais tempo dá lugar à nova.
+// ========================================================================
+
+#ifndef CACHE_IMAGENS_H
+#define CACHE_IMAGENS_H
+
+#include <stddef.h>
+#include <sys/stat.h>
+
+#define CACHE_CAMINHO_MAXIMO 256
+
+typedef struct
+{
+    char caminho[CACHE_CAMINHO_MAXIMO];
+    struct timespec modificacao;    // st_mtim do arquivo decodificado
+    off_t tamanho;
+    unsigned long uso;              // Relógio do último acesso (0 = livre)
+} EntradaCache;
+
+typedef struct
+{
+    EntradaCache *entradas;
+    unsigned char *quadros;         // capacidade x bytes_quadro, alinhados em 64
+    size_t bytes_quadro;
+    int capacidade;                 // 0 = cache desligado
+    int ocupadas;
+    unsigned long relogio;
+    unsigned long acertos;
+    unsigned long faltas;
+} CacheImagens;
+
+/**
+ * Aloca o cache de uma vez: cabem orcamento / bytes_quadro quadros
+ *
+ * @param cache: Estrutura a preencher
+ * @param orcamento: Memória dos quadros em bytes (menos de um quadro desliga o cache)
+ * @param bytes_quadro: Tamanho de um quadro (múltiplo de 64)
+ * @return 0 em sucesso, -1 se a alocação falhar
+ */
+int criar_cache_imagens(CacheImagens *cache, size_t orcamento, size_t bytes_quadro);
+
+void destruir_cache_imagens(CacheImagens *cache);
+
+/**
+ * Quadro guardado para o arquivo, se ele não mudou desde que foi
+ * decodificado (conta um acerto), ou NULL (conta uma falta)
+ *
+ * @param st: stat() atual do arquivo
+ */
+const unsigned char *procurar_no_cache(CacheImagens *cache, const char *caminho,
+                                       const struct stat *st);
+
+/**
+ * Quadro onde guardar a imagem recém-decodificada do arquivo: o da versão
+ * anterior do mesmo caminho, um livre ou o usado há mais tempo. NULL se o
+ * cache estiver desligado ou o caminho não couber na chave
+ */
+unsigned char *reservar_no_cache(CacheImagens *cache, const char *caminho,
+                                 const struct stat *st);
+
+#endif // CACHE_IMAGENS_H
@@ -4,6 +4,12 @@
 // 
 // Declara as funções Assembly disponíveis para controle do coprocessador
 // implementado na FPGA
+//
+// A mesma API é implementada por três backends, escolhidos na ligação
+// (make BACKEND=hw|ponte|modelo):
+//   hw     - coprocessador.s, ponte Lightweight real via /dev/mem
+//   ponte  - coprocessador_ponte.c, ponte simulada em arquivo (/dev/shm)
+//   modelo - ponte simulada + alu_modelo.c renderizando o framebuffer
 // ========================================================================
 
 #ifndef COPROCESSADOR_H
@@ -46,11 +52,56 @@ void encerrar_coprocessador(void);
  * @param tamanho: Tamanho da imagem em bytes (tipicamente 160x120 = 19200)
  * 
  * A imagem deve estar em escala de cinza (8 bits por pixel)
+ * Usa a estratégia de transferência mais rápida (carregar_imagem_neon)
  */
 void carregar_imagem(unsigned char *buffer_hps, int tamanho);
 
 /**
- * Limpa (zera) toda a memória de imagem na FPGA
+ * Estratégias de transferência de carregar_imagem
+ *
+ * Mesma assinatura e semântica de carregar_imagem; expostas para
+ * comparação de desempenho (bench/bench_carregar.c)
+ * - bytes: um LDRB/STRB por byte
+ * - words: um LDR/STR por word, byte a byte se desalinhado (original)
+ * - ldm:   rajadas LDM/STM de 32 bytes, realinha cabeça e cauda
+ * - neon:  rajadas NEON de 64 bytes, realinha cabeça e cauda
+ */
+void carregar_imagem_bytes(unsigned char *buffer_hps, int tamanho);
+void carregar_imagem_words(unsigned char *buffer_hps, int tamanho);
+void carregar_imagem_ldm(unsigned char *buffer_hps, int tamanho);
+void carregar_imagem_neon(unsigned char *buffer_hps, int tamanho);
+
+/**
+ * Carrega apenas um retângulo da imagem na memória da FPGA
+ *
+ * @param buffer_hps: Imagem completa na memória HPS (aponta para o pixel 0,0)
+ * @param x, y: Canto superior esquerdo do retângulo
+ * @param largura, altura: Dimensões do retângulo em pixels
+ * @param stride: Bytes por linha em buffer_hps (160 para uma imagem 160x120)
+ *
+ * Cada linha do retângulo é gravada na mesma posição (x, y) da memória
+ * de imagem; o restante da memória não é tocado. O retângulo é recortado
+ * aos limites 160x120, então pode ser passado parcialmente fora da imagem
+ */
+void carregar_regiao(unsigned char *buffer_hps, int x, int y,
+                     int largura, int altura, int stride);
+
+/**
+ * Banco de memória que a próxima carga vai escrever (0 ou 1)
+ *
+ * A memória de imagem tem dois bancos de 19200 bytes. As funções
+ * carregar_* escrevem sempre no banco que a ALU NÃO está lendo, então
+ * podem ser chamadas com a ALU ocupada. A próxima api_* aponta a ALU para
+ * o banco recém-carregado e a carga seguinte passa para o outro banco;
+ * sem carga nova, a ALU continua no mesmo banco.
+ *
+ * Como os bancos alternam, quem envia só regiões (carregar_regiao) deve
+ * acompanhar o conteúdo de cada banco separadamente
+ */
+int coprocessador_banco_carga(void);
+
+/**
+ * Limpa (zera) toda a memória de imagem na FPGA (os dois bancos)
  * 
  * Útil para resetar o estado antes de carregar nova imagem
  */
@@ -146,6 +197,198 @@ void api_replicacao_2x(void);
  */
 void api_replicacao_4x(void);
 
+// ------------------------------------------------------------------------
+// ALGORITMO: INTERPOLAÇÃO BILINEAR (Ampliação suavizada)
+// ------------------------------------------------------------------------
+
+/**
+ * Ampliação Bilinear - 2X
+ *
+ * Cada pixel de saída pondera os 4 vizinhos da imagem fonte com pesos
+ * em quartos (0 ou 1/2 em 2X); a última linha e coluna repetem a borda
+ * Opcode: 41
+ */
+void api_bilinear_2x(void);
+
+/**
+ * Ampliação Bilinear - 4X
+ *
+ * Como api_bilinear_2x(), com pesos 0, 1/4, 1/2 e 3/4
+ * Opcode: 42
+ */
+void api_bilinear_4x(void);
+
+// ------------------------------------------------------------------------
+// ALGORITMO: ESCALA DDA (Fator qualquer, vizinho mais próximo)
+// ------------------------------------------------------------------------
+
+/* Passo 16.16 de um fator de zoom: pixels da fonte por pixel da tela,
+ * arredondado para cima para a área não passar de 160*zoom pixels */
+#define PASSO_ESCALA(zoom) ((unsigned int)(65536.0 / (zoom) + 0.999999))
+
+/**
+ * Escala por um fator qualquer em cada eixo (1.5x, 3x, 0.75x, ...)
+ *
+ * @param passo_x, passo_y: Pixels da imagem fonte por pixel da tela, em
+ *                          ponto fixo 16.16 (0x10000 = 1x, 0x8000 = 2x,
+ *                          0x20000 = 0.5x); veja PASSO_ESCALA
+ *
+ * O pixel n da tela lê o pixel floor(n * passo) da fonte. A área tem
+ * ceil(L / passo_x) x ceil(A / passo_y) pixels, limitada a 640x480, onde
+ * L x A é a ROI (coprocessador_roi) ou 160x120,
+ * e fica centralizada; a ALU a mede antes de desenhar (até 641 ciclos).
+ * Passos 0x8000 e 0x20000 reproduzem api_vizinho_2x e api_vizinho_0_5x
+ * Opcode: 48
+ */
+void api_escala(unsigned int passo_x, unsigned int passo_y);
+
+// ========================================================================
+// STATUS DA ALU (pio_status)
+// ========================================================================
+
+/**
+ * Verifica, sem bloquear, se a ALU ainda está processando
+ *
+ * @return 1 enquanto a operação disparada pela última api_* não terminou,
+ *         0 caso contrário
+ *
+ * Opcodes sem FSM no hardware nunca terminam e ficam ocupados
+ */
+int coprocessador_ocupado(void);
+
+/**
+ * Ciclos de clock da ALU (25 MHz) gastos pela operação atual
+ *
+ * O contador zera a cada start e congela quando a operação termina,
+ * então após a conclusão retorna a duração total da última operação
+ */
+unsigned int coprocessador_ciclos(void);
+
+/**
+ * Parte de coprocessador_ciclos() gasta fora da área ativa (pio_limpeza)
+ *
+ * Nenhum opcode limpa o framebuffer: o VGA pinta de preto o que está fora
+ * da área da última operação. Sobram os saltos de borda das varreduras
+ * (um por linha da área, mais um); o vizinho in e a replicação só visitam
+ * a área e retornam 0. Congela junto com coprocessador_ciclos()
+ */
+unsigned int coprocessador_ciclos_limpeza(void);
+
+/**
+ * Espera a operação atual terminar
+ *
+ * @param timeout_us: Tempo máximo de espera em microssegundos
+ *                    (negativo = espera sem limite)
+ * @return 0 se a operação terminou, -1 se o tempo esgotou
+ *
+ * A ALU lê apenas o seu banco da memória de imagem, então as cargas não
+ * precisam esperar; chame antes da próxima api_* para não reiniciar a ALU
+ * no meio de uma operação
+ */
+int aguardar_conclusao(int timeout_us);
+
+// ========================================================================
+// CONTADORES DE DESEMPENHO (pio_contador_sel, pio_contador)
+// ========================================================================
+
+/**
+ * Banco de contadores da ALU (contadores_alu.v), na ordem dos índices do
+ * hardware. Ciclos e latência em clock da ALU (25 MHz)
+ */
+typedef struct
+{
+    unsigned int ciclos;          // Duração da operação (= coprocessador_ciclos)
+    unsigned int ciclos_limpeza;  // Parte fora da área (= coprocessador_ciclos_limpeza)
+    unsigned int leituras_rom;    // Pixels lidos da memória de imagem
+    unsigned int escritas_fb;     // Pixels escritos no framebuffer
+    unsigned int latencia;        // Do pulso de start ao done
+    unsigned int concluidas;      // Operações terminadas desde a configuração
+    unsigned int abortadas;       // Operações interrompidas por um novo start
+} ContadoresCoprocessador;
+
+/**
+ * Lê todos os contadores de desempenho
+ *
+ * @param contadores: Destino das leituras
+ *
+ * Os contadores da operação (ciclos a latencia) zeram a cada start e
+ * congelam no done; concluidas e abortadas acumulam entre operações.
+ * A latência inclui a largura do pulso de start escrito pelo HPS, então
+ * latencia - ciclos mede o custo da ponte. Leia após aguardar_conclusao()
+ * para que os valores formem um retrato da mesma operação
+ */
+void coprocessador_ler_contadores(ContadoresCoprocessador *contadores);
+
+// ========================================================================
+// SINCRONISMO DO VGA (pio_vga)
+// ========================================================================
+
+/**
+ * Contador de quadros do VGA (640x480 a ~60 Hz)
+ *
+ * Incrementa no início de cada retraço vertical, quando termina a última
+ * linha visível. Duas leituras iguais significam que o monitor ainda está
+ * no mesmo quadro; use para limitar atualizações a uma por quadro
+ */
+unsigned int coprocessador_quadro(void);
+
+/**
+ * Verifica se o VGA está no retraço vertical (fora das linhas visíveis)
+ *
+ * @return 1 durante o vblank (~1,4 ms de cada quadro), 0 caso contrário
+ */
+int coprocessador_em_vblank(void);
+
+// ========================================================================
+// OVERLAY DO VGA (pio_cursor, pio_janela_ini, pio_janela_fim)
+// ========================================================================
+
+/* Modos de overlay_janela */
+#define OVERLAY_OCULTO    0
+#define OVERLAY_RETANGULO 1
+#define OVERLAY_CANTO     2
+
+/**
+ * Posiciona o cursor desenhado pelo hardware sobre a saída VGA
+ *
+ * @param x, y: Centro da cruz em pixels da tela (0-639, 0-479)
+ * @param visivel: 0 oculta o cursor
+ *
+ * O cursor não é gravado no framebuffer nem na imagem fonte: mover o
+ * mouse custa uma escrita de registrador, sem carga nem operação da ALU
+ */
+void overlay_cursor(int x, int y, int visivel);
+
+/**
+ * Desenha a janela de seleção sobre a saída VGA
+ *
+ * @param modo: OVERLAY_OCULTO, OVERLAY_RETANGULO ou OVERLAY_CANTO
+ * @param x1, y1: Canto superior esquerdo (vértice do L no modo canto)
+ * @param x2, y2: Canto inferior direito (fim dos braços no modo canto)
+ *
+ * Coordenadas em pixels da tela, com x1 <= x2 e y1 <= y2
+ */
+void overlay_janela(int modo, int x1, int y1, int x2, int y2);
+
+// ========================================================================
+// REGIÃO DE INTERESSE (pio_roi)
+// ========================================================================
+
+/**
+ * Restringe as próximas operações a um retângulo da imagem fonte
+ *
+ * @param x, y: Canto superior esquerdo na imagem 160x120
+ * @param largura, altura: Dimensões em pixels (0 = imagem inteira)
+ *
+ * A ALU lê só essa janela do banco, como se fosse a imagem inteira, e
+ * centraliza o resultado na tela: a área de cada opcode passa a ser a
+ * da ROI vezes o fator de zoom. Selecionar ou ampliar uma região custa
+ * uma escrita de registrador, sem recarregar a imagem. O retângulo é
+ * recortado aos limites da imagem; vazio, a ROI fica desativada.
+ * Vale a partir da próxima api_*
+ */
+void coprocessador_roi(int x, int y, int largura, int altura);
+
 // ========================================================================
 // FUNÇÕES AUXILIARES (se necessário expor)
 // ========================================================================
@@ -154,6 +397,7 @@ void api_replicacao_4x(void);
  * Processa imagem com operação genérica
  * 
  * @param operacao: Código da operação (0-1023, 10 bits)
+ *                  O bit 7 é reservado para a seleção de banco e ignorado
  * 
  * Função de baixo nível que permite enviar qualquer opcode
  * Prefira usar as funções específicas (api_*) ao invés desta
@@ -3,6 +3,10 @@
 @ Arquitetura: Funções de alto nível que encapsulam opcodes
 @ ========================================================================
 
+.syntax unified
+.arch armv7-a
+.fpu neon
+
 .section .text
 .align 4
 
@@ -16,11 +20,59 @@
 .global carregar_imagem
 .type carregar_imagem, %function
 
+.global carregar_imagem_bytes
+.type carregar_imagem_bytes, %function
+
+.global carregar_imagem_words
+.type carregar_imagem_words, %function
+
+.global carregar_imagem_ldm
+.type carregar_imagem_ldm, %function
+
+.global carregar_imagem_neon
+.type carregar_imagem_neon, %function
+
+.global carregar_regiao
+.type carregar_regiao, %function
+
 .global limpar_imagem
 .type limpar_imagem, %function
 
 .global processar_imagem
 
+.global coprocessador_banco_carga
+.type coprocessador_banco_carga, %function
+
+.global coprocessador_ocupado
+.type coprocessador_ocupado, %function
+
+.global coprocessador_ciclos
+.type coprocessador_ciclos, %function
+
+.global coprocessador_ciclos_limpeza
+.type coprocessador_ciclos_limpeza, %function
+
+.global aguardar_conclusao
+.type aguardar_conclusao, %function
+
+.global coprocessador_ler_contadores
+.type coprocessador_ler_contadores, %function
+
+.global coprocessador_quadro
+.type coprocessador_quadro, %function
+
+.global coprocessador_em_vblank
+.type coprocessador_em_vblank, %function
+
+.global overlay_cursor
+.type overlay_cursor, %function
+
+.global overlay_janela
+.type overlay_janela, %function
+
+.global coprocessador_roi
+.type coprocessador_roi, %function
+
 .global api_bypass
 .type api_bypass, %function
 
@@ -48,6 +100,15 @@
 .global api_replicacao_4x
 .type api_replicacao_4x, %function
 
+.global api_bilinear_2x
+.type api_bilinear_2x, %function
+
+.global api_bilinear_4x
+.type api_bilinear_4x, %function
+
+.global api_escala
+.type api_escala, %function
+
 
 
 
@@ -95,6 +156,24 @@ iniciar_coprocessador:
         LDR     R1, =FPGA_VIRTUAL_ADDR
         STR     R0, [R1, #0]
 
+        @ Bancos: a ALU começa lendo o banco 0, as cargas vão para o banco 1
+        LDR     R1, =IMAGE_MEM_OFFSET
+        LDR     R1, [R1, #0]
+        ADD     R0, R0, R1
+        LDR     R1, =IMAGE_SIZE
+        LDR     R1, [R1, #0]
+        ADD     R0, R0, R1          @ base + 1 * IMAGE_SIZE
+        LDR     R1, =ENDERECO_CARGA
+        STR     R0, [R1, #0]
+        MOV     R0, #1
+        LDR     R1, =BANCO_CARGA
+        STR     R0, [R1, #0]
+        MOV     R0, #0
+        LDR     R1, =BANCO_ALU
+        STR     R0, [R1, #0]
+        LDR     R1, =CARGA_PENDENTE
+        STR     R0, [R1, #0]
+
         LDR     R0, [SP, #0]
         LDR     R1, [SP, #4]
         LDR     R2, [SP, #8]
@@ -144,10 +223,53 @@ encerrar_coprocessador:
 @ Transfere imagem do buffer HPS para memória FPGA
 @ R0 = ponteiro para buffer na memória HPS
 @ R1 = tamanho da imagem em bytes
+@
+@ Usa a estratégia mais rápida (NEON, 64 bytes por iteração). As demais
+@ estratégias continuam exportadas para comparação no benchmark
 @ ========================================================================
 
 
 carregar_imagem:
+        B       carregar_imagem_neon    @ Tail call, mesmos argumentos
+
+@ ========================================================================
+@ void carregar_imagem_bytes(unsigned char *buffer_hps, int tamanho)
+@ Estratégia 1: um LDRB/STRB por byte (referência)
+@ ========================================================================
+
+
+carregar_imagem_bytes:
+        PUSH    {R4-R6, LR}
+
+        MOV     R4, R0              @ origem
+        MOV     R6, R1              @ bytes a copiar
+
+        LDR     R5, =ENDERECO_CARGA
+        LDR     R5, [R5, #0]        @ destino: banco de carga
+        LDR     R3, =CARGA_PENDENTE
+        MOV     R12, #1
+        STR     R12, [R3, #0]       @ processar_imagem troca de banco
+
+        CMP     R6, #0
+        BLE     bytes_done
+
+bytes_loop:
+        LDRB    R3, [R4], #1
+        STRB    R3, [R5], #1
+        SUBS    R6, R6, #1
+        BNE     bytes_loop
+
+bytes_done:
+        DSB
+        POP     {R4-R6, PC}
+
+@ ========================================================================
+@ void carregar_imagem_words(unsigned char *buffer_hps, int tamanho)
+@ Estratégia 2: um LDR/STR por word; cai para bytes se desalinhado
+@ ========================================================================
+
+
+carregar_imagem_words:
         PUSH    {R4-R7, LR}
         
         @ R4 = origem (memória HPS) endereço
@@ -156,12 +278,15 @@ carregar_imagem:
         MOV     R4, R0 
         MOV     R6, R1      @19200
         
-        @ Calcula endereço destino: virtual_base + IMAGE_MEM_OFFSET
-        LDR     R5, =FPGA_VIRTUAL_ADDR
+        @ Endereço destino: banco de carga
+        LDR     R5, =ENDERECO_CARGA
         LDR     R5, [R5, #0]
-        LDR     R7, =IMAGE_MEM_OFFSET
-        LDR     R7, [R7, #0]
-        ADD     R5, R5, R7          @ endereço destino
+        LDR     R7, =CARGA_PENDENTE
+        MOV     R3, #1
+        STR     R3, [R7, #0]        @ processar_imagem troca de banco
+
+        CMP     R6, #0
+        BLE     transfer_done
 
         @ Verifica alinhamento para otimização
         ORR     R7, R4, R5          @ Combina ambos os endereços
@@ -194,9 +319,262 @@ transfer_done:
         DSB                         @ Garante conclusão das escritas(Data Synchronization Barrier)
         POP     {R4-R7, PC}         @ Retorna 
 
+@ ========================================================================
+@ void carregar_imagem_ldm(unsigned char *buffer_hps, int tamanho)
+@ Estratégia 3: rajadas LDM/STM de 32 bytes (8 registradores)
+@
+@ Cabeça: bytes até o destino (FPGA) ficar alinhado em 4
+@ Corpo:  LDM/STM se a origem também ficar alinhada; senão 8 LDRs
+@         desalinhados (permitidos no ARMv7) + um STM alinhado
+@ Cauda:  words e depois bytes
+@ ========================================================================
+
+
+carregar_imagem_ldm:
+        PUSH    {R4-R10, LR}
+
+        MOV     R4, R0              @ origem
+        MOV     R6, R1              @ bytes a copiar
+
+        LDR     R5, =ENDERECO_CARGA
+        LDR     R5, [R5, #0]        @ destino: banco de carga
+        LDR     R3, =CARGA_PENDENTE
+        MOV     R12, #1
+        STR     R12, [R3, #0]       @ processar_imagem troca de banco
+
+ldm_head:
+        CMP     R6, #0
+        BLE     ldm_done
+        TST     R5, #3              @ Destino alinhado em 4?
+        BEQ     ldm_bloco
+        LDRB    R3, [R4], #1
+        STRB    R3, [R5], #1
+        SUB     R6, R6, #1
+        B       ldm_head
+
+ldm_bloco:
+        LSRS    R12, R6, #5         @ Número de blocos de 32 bytes
+        BEQ     ldm_cauda
+        AND     R6, R6, #31         @ Sobra para a cauda
+        TST     R4, #3              @ Origem alinhada em 4?
+        BNE     ldm_loop_desalinhado
+
+ldm_loop:
+        LDMIA   R4!, {R0-R3, R7-R10}
+        STMIA   R5!, {R0-R3, R7-R10}
+        SUBS    R12, R12, #1
+        BNE     ldm_loop
+        B       ldm_cauda
+
+ldm_loop_desalinhado:
+        LDR     R0, [R4], #4
+        LDR     R1, [R4], #4
+        LDR     R2, [R4], #4
+        LDR     R3, [R4], #4
+        LDR     R7, [R4], #4
+        LDR     R8, [R4], #4
+        LDR     R9, [R4], #4
+        LDR     R10, [R4], #4
+        STMIA   R5!, {R0-R3, R7-R10}
+        SUBS    R12, R12, #1
+        BNE     ldm_loop_desalinhado
+
+ldm_cauda:
+        LSRS    R12, R6, #2         @ Words restantes
+        BEQ     ldm_cauda_bytes
+
+ldm_cauda_words:
+        LDR     R3, [R4], #4
+        STR     R3, [R5], #4
+        SUBS    R12, R12, #1
+        BNE     ldm_cauda_words
+
+ldm_cauda_bytes:
+        ANDS    R6, R6, #3          @ Bytes restantes
+        BEQ     ldm_done
+
+ldm_byte_loop:
+        LDRB    R3, [R4], #1
+        STRB    R3, [R5], #1
+        SUBS    R6, R6, #1
+        BNE     ldm_byte_loop
+
+ldm_done:
+        DSB
+        POP     {R4-R10, PC}
+
+@ ========================================================================
+@ void carregar_imagem_neon(unsigned char *buffer_hps, int tamanho)
+@ Estratégia 4: rajadas NEON de 64 bytes (D0-D7)
+@
+@ Cabeça: bytes até o destino ficar alinhado em 16
+@ Corpo:  VLD1.8 (aceita qualquer alinhamento na origem) + VST1 alinhado
+@ Cauda:  words e depois bytes
+@ D0-D7 são caller-saved pela AAPCS, não precisam ser preservados
+@ ========================================================================
+
+
+carregar_imagem_neon:
+        PUSH    {R4-R6, LR}
+
+        MOV     R4, R0              @ origem
+        MOV     R6, R1              @ bytes a copiar
+
+        LDR     R5, =ENDERECO_CARGA
+        LDR     R5, [R5, #0]        @ destino: banco de carga
+        LDR     R3, =CARGA_PENDENTE
+        MOV     R12, #1
+        STR     R12, [R3, #0]       @ processar_imagem troca de banco
+
+neon_head:
+        CMP     R6, #0
+        BLE     neon_done
+        TST     R5, #15             @ Destino alinhado em 16?
+        BEQ     neon_bloco
+        LDRB    R3, [R4], #1
+        STRB    R3, [R5], #1
+        SUB     R6, R6, #1
+        B       neon_head
+
+neon_bloco:
+        LSRS    R12, R6, #6         @ Número de blocos de 64 bytes
+        BEQ     neon_cauda
+        AND     R6, R6, #63         @ Sobra para a cauda
+
+neon_loop:
+        VLD1.8  {D0-D3}, [R4]!
+        VLD1.8  {D4-D7}, [R4]!
+        VST1.8  {D0-D3}, [R5:128]!
+        VST1.8  {D4-D7}, [R5:128]!
+        SUBS    R12, R12, #1
+        BNE     neon_loop
+
+neon_cauda:
+        LSRS    R12, R6, #2         @ Words restantes (origem pode estar desalinhada)
+        BEQ     neon_cauda_bytes
+
+neon_cauda_words:
+        LDR     R3, [R4], #4
+        STR     R3, [R5], #4
+        SUBS    R12, R12, #1
+        BNE     neon_cauda_words
+
+neon_cauda_bytes:
+        ANDS    R6, R6, #3          @ Bytes restantes
+        BEQ     neon_done
+
+neon_byte_loop:
+        LDRB    R3, [R4], #1
+        STRB    R3, [R5], #1
+        SUBS    R6, R6, #1
+        BNE     neon_byte_loop
+
+neon_done:
+        DSB                         @ Garante conclusão das escritas
+        POP     {R4-R6, PC}
+
+@ ========================================================================
+@ void carregar_regiao(unsigned char *buffer_hps, int x, int y,
+@                      int largura, int altura, int stride)
+@ Transfere apenas um retângulo da imagem para a memória FPGA
+@ R0 = buffer HPS (pixel 0,0 da imagem completa)
+@ R1 = x, R2 = y, R3 = largura
+@ [SP] = altura, [SP, #4] = stride (bytes por linha no buffer HPS)
+@
+@ O retângulo é recortado aos limites 160x120 e cada linha é gravada na
+@ mesma posição (x, y) da memória FPGA: bytes até o destino alinhar em 4,
+@ words (origem pode estar desalinhada) e bytes no final
+@ ========================================================================
+
+
+carregar_regiao:
+        PUSH    {R4-R10, LR}
+
+        LDR     R4, [SP, #32]       @ altura
+        LDR     R5, [SP, #36]       @ stride
+
+        @ Recorte à esquerda e acima (a origem é indexada pelas mesmas coordenadas)
+        CMP     R1, #0
+        ADDLT   R3, R3, R1          @ largura += x
+        MOVLT   R1, #0
+        CMP     R2, #0
+        ADDLT   R4, R4, R2          @ altura += y
+        MOVLT   R2, #0
+
+        @ Recorte à direita e abaixo
+        LDR     R9, =IMAGE_WIDTH
+        LDR     R9, [R9, #0]
+        SUB     R6, R9, R1
+        CMP     R3, R6
+        MOVGT   R3, R6
+        LDR     R7, =IMAGE_HEIGHT
+        LDR     R7, [R7, #0]
+        SUB     R6, R7, R2
+        CMP     R4, R6
+        MOVGT   R4, R6
+
+        CMP     R3, #0
+        BLE     regiao_done
+        CMP     R4, #0
+        BLE     regiao_done
+
+        @ R0 = origem da primeira linha: buffer + y*stride + x
+        MLA     R0, R2, R5, R0
+        ADD     R0, R0, R1
+
+        @ R8 = destino da primeira linha: banco de carga + y*IMAGE_WIDTH + x
+        LDR     R8, =ENDERECO_CARGA
+        LDR     R8, [R8, #0]
+        LDR     R6, =CARGA_PENDENTE
+        MOV     R7, #1
+        STR     R7, [R6, #0]        @ processar_imagem troca de banco
+        MLA     R8, R2, R9, R8
+        ADD     R8, R8, R1
+
+regiao_linha:
+        MOV     R6, R0              @ origem da linha
+        MOV     R7, R8              @ destino da linha
+        MOV     R10, R3             @ bytes da linha
+
+regiao_head:
+        TST     R7, #3              @ Destino alinhado em 4?
+        BEQ     regiao_words
+        LDRB    R12, [R6], #1
+        STRB    R12, [R7], #1
+        SUBS    R10, R10, #1
+        BNE     regiao_head
+        B       regiao_proxima
+
+regiao_words:
+        SUBS    R10, R10, #4
+        BLT     regiao_cauda
+        LDR     R12, [R6], #4
+        STR     R12, [R7], #4
+        B       regiao_words
+
+regiao_cauda:
+        ADDS    R10, R10, #4        @ Bytes restantes (0-3)
+        BEQ     regiao_proxima
+
+regiao_byte_loop:
+        LDRB    R12, [R6], #1
+        STRB    R12, [R7], #1
+        SUBS    R10, R10, #1
+        BNE     regiao_byte_loop
+
+regiao_proxima:
+        ADD     R0, R0, R5          @ Próxima linha na origem (stride)
+        ADD     R8, R8, R9          @ Próxima linha no destino (160)
+        SUBS    R4, R4, #1
+        BNE     regiao_linha
+
+regiao_done:
+        DSB                         @ Garante conclusão das escritas
+        POP     {R4-R10, PC}
+
 @ ========================================================================
 @ void limpar_imagem(void)
-@ Limpa (zera) toda a memória de imagem
+@ Limpa (zera) toda a memória de imagem (os dois bancos)
 @ ========================================================================
 
 limpar_imagem:
@@ -212,6 +590,7 @@ limpar_imagem:
         @ Tamanho
         LDR     R6, =IMAGE_SIZE     @ Tamanho da imagem em bytes
         LDR     R6, [R6, #0]       
+        LSL     R6, R6, #1          @ Dois bancos
         
         MOV     R7, #0              @ Valor para preencher
         
@@ -305,17 +684,334 @@ delay_start:
 @ void processar_imagem(int operacao)
 @ Função interna - processa imagem com operação especificada
 @ R0 = código da operação
+@
+@ O bit 7 da configuração escolhe o banco lido pela ALU. Se houve carga
+@ desde o último start, a ALU passa a ler o banco de carga e as próximas
+@ cargas vão para o outro; senão reprocessa o mesmo banco
 
 processar_imagem:
-        PUSH    {LR}             
+        PUSH    {R4, LR}             
+
+        BIC     R0, R0, #0x80       @ Bit 7 é reservado para o banco
+
+        LDR     R1, =CARGA_PENDENTE
+        LDR     R2, [R1, #0]
+        CMP     R2, #0
+        BEQ     processar_mesmo_banco
+
+        @ Troca de banco
+        MOV     R2, #0
+        STR     R2, [R1, #0]        @ Limpa CARGA_PENDENTE
+        LDR     R1, =BANCO_CARGA
+        LDR     R2, [R1, #0]
+        LDR     R3, =BANCO_ALU
+        STR     R2, [R3, #0]        @ ALU lê o banco recém-carregado
+        EOR     R2, R2, #1
+        STR     R2, [R1, #0]        @ Cargas vão para o outro banco
+
+        @ ENDERECO_CARGA = virtual_base + IMAGE_MEM_OFFSET + banco * IMAGE_SIZE
+        LDR     R1, =FPGA_VIRTUAL_ADDR
+        LDR     R1, [R1, #0]
+        LDR     R3, =IMAGE_MEM_OFFSET
+        LDR     R3, [R3, #0]
+        ADD     R1, R1, R3
+        LDR     R3, =IMAGE_SIZE
+        LDR     R3, [R3, #0]
+        MLA     R1, R2, R3, R1
+        LDR     R3, =ENDERECO_CARGA
+        STR     R1, [R3, #0]
+
+processar_mesmo_banco:
+        LDR     R1, =BANCO_ALU
+        LDR     R1, [R1, #0]
+        ORR     R0, R0, R1, LSL #7  @ Banco lido pela ALU
         
-        @ Escreve configuração (operação)
+        @ Escreve configuração (operação + banco)
         BL      escrever_config
         
         @ Envia trigger 
         BL      enviar_start
         
-        POP     {PC}    
+        POP     {R4, PC}    
+
+
+@ int coprocessador_banco_carga(void)
+@ Retorna o banco (0 ou 1) que recebe as próximas cargas
+coprocessador_banco_carga:
+        LDR     R0, =BANCO_CARGA
+        LDR     R0, [R0, #0]
+        BX      LR
+
+
+
+@ ========================================================================
+@ STATUS DA ALU
+@ pio_status = {ciclos[29:0], ocupado, concluido}
+@ ========================================================================
+
+@ int coprocessador_ocupado(void)
+@ Retorna 1 enquanto a operação atual não terminou
+coprocessador_ocupado:
+        LDR     R0, =FPGA_VIRTUAL_ADDR
+        LDR     R0, [R0, #0]
+        LDR     R1, =STATUS_PIO_OFFSET
+        LDR     R1, [R1, #0]
+        LDR     R0, [R0, R1]        @ Lê o PIO de status
+        UBFX    R0, R0, #1, #1      @ Bit 1 = ocupado
+        BX      LR
+
+
+@ unsigned int coprocessador_ciclos(void)
+@ Retorna os ciclos de clk25 gastos pela operação atual/última
+coprocessador_ciclos:
+        LDR     R0, =FPGA_VIRTUAL_ADDR
+        LDR     R0, [R0, #0]
+        LDR     R1, =STATUS_PIO_OFFSET
+        LDR     R1, [R1, #0]
+        LDR     R0, [R0, R1]
+        LSR     R0, R0, #2          @ Bits [31:2] = ciclos
+        BX      LR
+
+
+@ unsigned int coprocessador_ciclos_limpeza(void)
+@ Retorna a parte dos ciclos gasta limpando o framebuffer (pio_limpeza)
+coprocessador_ciclos_limpeza:
+        LDR     R0, =FPGA_VIRTUAL_ADDR
+        LDR     R0, [R0, #0]
+        LDR     R1, =LIMPEZA_PIO_OFFSET
+        LDR     R1, [R1, #0]
+        LDR     R0, [R0, R1]
+        BX      LR
+
+
+@ int aguardar_conclusao(int timeout_us)
+@ Espera o bit concluido do PIO de status
+@ R0 = timeout em microssegundos (negativo = sem limite)
+@ Retorna 0 se concluiu, -1 se o tempo esgotou
+aguardar_conclusao:
+        PUSH    {R4-R6, LR}
+
+        MOV     R4, R0              @ timeout
+
+        LDR     R5, =FPGA_VIRTUAL_ADDR
+        LDR     R5, [R5, #0]
+        LDR     R1, =STATUS_PIO_OFFSET
+        LDR     R1, [R1, #0]
+        ADD     R5, R5, R1          @ Endereço do PIO de status
+
+        BL      ler_tempo_us
+        MOV     R6, R0              @ Instante inicial
+
+aguardar_loop:
+        LDR     R0, [R5, #0]
+        TST     R0, #1              @ Bit 0 = concluido
+        BNE     aguardar_ok
+
+        CMP     R4, #0
+        BLT     aguardar_loop       @ Sem limite de tempo
+
+        BL      ler_tempo_us
+        SUB     R0, R0, R6          @ Tempo decorrido (módulo 2^32)
+        CMP     R0, R4
+        BLO     aguardar_loop
+
+        MVN     R0, #0              @ -1: tempo esgotado
+        POP     {R4-R6, PC}
+
+aguardar_ok:
+        MOV     R0, #0
+        POP     {R4-R6, PC}
+
+
+@ unsigned int ler_tempo_us(void)
+@ Função interna - CLOCK_MONOTONIC em microssegundos (32 bits, circular)
+ler_tempo_us:
+        PUSH    {R7, LR}
+        SUB     SP, SP, #8          @ struct timespec
+
+        MOV     R0, #1              @ CLOCK_MONOTONIC
+        MOV     R1, SP
+        LDR     R7, =263            @ sys_clock_gettime
+        SVC     0
+
+        LDR     R0, [SP, #0]        @ tv_sec
+        LDR     R1, [SP, #4]        @ tv_nsec
+        LDR     R2, =1000000
+        MUL     R0, R0, R2          @ segundos -> us
+        LDR     R2, =0x10624DD3     @ 2^38 / 1000 (divisão por 1000)
+        UMULL   R3, R12, R1, R2
+        ADD     R0, R0, R12, LSR #6 @ + tv_nsec / 1000
+
+        ADD     SP, SP, #8
+        POP     {R7, PC}
+
+
+@ unsigned int coprocessador_quadro(void)
+@ Retorna o contador de quadros do VGA (incrementa a cada vblank)
+coprocessador_quadro:
+        LDR     R0, =FPGA_VIRTUAL_ADDR
+        LDR     R0, [R0, #0]
+        LDR     R1, =VGA_PIO_OFFSET
+        LDR     R1, [R1, #0]
+        LDR     R0, [R0, R1]        @ Lê o PIO do VGA
+        LSR     R0, R0, #1          @ Bits [31:1] = quadros
+        BX      LR
+
+
+@ int coprocessador_em_vblank(void)
+@ Retorna 1 durante o retraço vertical, 0 nas linhas visíveis
+coprocessador_em_vblank:
+        LDR     R0, =FPGA_VIRTUAL_ADDR
+        LDR     R0, [R0, #0]
+        LDR     R1, =VGA_PIO_OFFSET
+        LDR     R1, [R1, #0]
+        LDR     R0, [R0, R1]
+        AND     R0, R0, #1          @ Bit 0 = vblank
+        BX      LR
+
+
+@ ========================================================================
+@ CONTADORES DE DESEMPENHO
+@ pio_contador_sel = índice, pio_contador = valor (contadores_alu.v)
+@ ========================================================================
+
+@ void coprocessador_ler_contadores(ContadoresCoprocessador *contadores)
+@ Percorre o banco: escreve o índice e lê o valor, na ordem dos campos
+@ R0 = destino (TOTAL_CONTADORES words)
+coprocessador_ler_contadores:
+        PUSH    {R4-R5, LR}
+
+        LDR     R3, =FPGA_VIRTUAL_ADDR
+        LDR     R3, [R3, #0]
+        LDR     R1, =CONTADOR_SEL_PIO_OFFSET
+        LDR     R1, [R1, #0]
+        ADD     R4, R3, R1          @ Endereço do seletor
+        LDR     R1, =CONTADOR_PIO_OFFSET
+        LDR     R1, [R1, #0]
+        ADD     R5, R3, R1          @ Endereço do valor
+
+        MOV     R2, #0              @ Índice
+contadores_loop:
+        STR     R2, [R4]
+        DSB
+        LDR     R3, [R5]            @ Descartada: o valor é registrado em clk25
+        LDR     R3, [R5]            @ e acompanha o índice um ciclo depois
+        STR     R3, [R0, R2, LSL #2]
+        ADD     R2, R2, #1
+        CMP     R2, #7              @ TOTAL_CONTADORES
+        BLT     contadores_loop
+
+        POP     {R4-R5, PC}
+
+
+@ ========================================================================
+@ OVERLAY DO VGA
+@ Registradores {..., y[19:10], x[9:0]} lidos pelo overlay_vga.v
+@ ========================================================================
+
+@ void overlay_cursor(int x, int y, int visivel)
+@ R0 = x, R1 = y, R2 = visivel
+overlay_cursor:
+        LDR     R3, =0x3FF
+        AND     R0, R0, R3          @ x[9:0]
+        AND     R1, R1, R3
+        ORR     R0, R0, R1, LSL #10 @ y[19:10]
+        CMP     R2, #0
+        ORRNE   R0, R0, #0x100000   @ visivel[20]
+
+        LDR     R1, =FPGA_VIRTUAL_ADDR
+        LDR     R1, [R1, #0]
+        LDR     R2, =CURSOR_PIO_OFFSET
+        LDR     R2, [R2, #0]
+        STR     R0, [R1, R2]
+        DSB
+        BX      LR
+
+
+@ void overlay_janela(int modo, int x1, int y1, int x2, int y2)
+@ R0 = modo, R1 = x1, R2 = y1, R3 = x2, [SP] = y2
+overlay_janela:
+        PUSH    {R4-R6, LR}
+        LDR     R4, [SP, #16]       @ y2 (5º argumento)
+
+        LDR     R5, =0x3FF
+        AND     R3, R3, R5
+        AND     R4, R4, R5
+        ORR     R3, R3, R4, LSL #10 @ {y2, x2}
+
+        AND     R1, R1, R5
+        AND     R2, R2, R5
+        ORR     R1, R1, R2, LSL #10 @ {y1, x1}
+        AND     R0, R0, #3
+        ORR     R1, R1, R0, LSL #20 @ modo[21:20]
+
+        LDR     R5, =FPGA_VIRTUAL_ADDR
+        LDR     R5, [R5, #0]
+
+        @ Fim primeiro: o modo só ativa com as duas pontas prontas
+        LDR     R6, =JANELA_FIM_PIO_OFFSET
+        LDR     R6, [R6, #0]
+        STR     R3, [R5, R6]
+        LDR     R6, =JANELA_INI_PIO_OFFSET
+        LDR     R6, [R6, #0]
+        STR     R1, [R5, R6]
+        DSB
+
+        POP     {R4-R6, PC}
+
+
+
+@ ========================================================================
+@ REGIÃO DE INTERESSE
+@ pio_roi = {ativa[31], alt[30:24], larg[23:16], y0[14:8], x0[7:0]}
+@ ========================================================================
+
+@ void coprocessador_roi(int x, int y, int largura, int altura)
+@ R0 = x, R1 = y, R2 = largura, R3 = altura
+@ Recorta aos limites 160x120 (como carregar_regiao); vazia desativa
+coprocessador_roi:
+        PUSH    {R4-R5, LR}
+
+        @ Recorte à esquerda e acima
+        CMP     R0, #0
+        ADDLT   R2, R2, R0          @ largura += x
+        MOVLT   R0, #0
+        CMP     R1, #0
+        ADDLT   R3, R3, R1          @ altura += y
+        MOVLT   R1, #0
+
+        @ Recorte à direita e abaixo
+        LDR     R4, =IMAGE_WIDTH
+        LDR     R4, [R4, #0]
+        SUB     R4, R4, R0
+        CMP     R2, R4
+        MOVGT   R2, R4
+        LDR     R4, =IMAGE_HEIGHT
+        LDR     R4, [R4, #0]
+        SUB     R4, R4, R1
+        CMP     R3, R4
+        MOVGT   R3, R4
+
+        MOV     R5, #0              @ ROI inativa
+        CMP     R2, #0
+        BLE     roi_escrever
+        CMP     R3, #0
+        BLE     roi_escrever
+
+        ORR     R5, R0, R1, LSL #8  @ x0[7:0], y0[14:8]
+        ORR     R5, R5, R2, LSL #16 @ larg[23:16]
+        ORR     R5, R5, R3, LSL #24 @ alt[30:24]
+        ORR     R5, R5, #0x80000000 @ ativa[31]
+
+roi_escrever:
+        LDR     R4, =FPGA_VIRTUAL_ADDR
+        LDR     R4, [R4, #0]
+        LDR     R0, =ROI_PIO_OFFSET
+        LDR     R0, [R0, #0]
+        STR     R5, [R4, R0]
+        DSB
+
+        POP     {R4-R5, PC}
 
 
 
@@ -400,6 +1096,42 @@ api_replicacao_4x:
         BL      processar_imagem
         POP     {PC}
 
+
+@ void api_bilinear_2x(void)
+api_bilinear_2x:
+        PUSH    {LR}
+        MOV     R0, #41             @ Opcode 41
+        BL      processar_imagem
+        POP     {PC}
+
+
+@ void api_bilinear_4x(void)
+api_bilinear_4x:
+        PUSH    {LR}
+        MOV     R0, #42             @ Opcode 42
+        BL      processar_imagem
+        POP     {PC}
+
+
+@ void api_escala(unsigned int passo_x, unsigned int passo_y)
+@ R0 = passo_x, R1 = passo_y (16.16, pixels da fonte por pixel da tela)
+@ Os passos são capturados pela ALU no pulso de start
+api_escala:
+        PUSH    {LR}
+        LDR     R2, =FPGA_VIRTUAL_ADDR
+        LDR     R2, [R2, #0]
+        LDR     R3, =PASSO_X_PIO_OFFSET
+        LDR     R3, [R3, #0]
+        STR     R0, [R2, R3]
+        LDR     R3, =PASSO_Y_PIO_OFFSET
+        LDR     R3, [R3, #0]
+        STR     R1, [R2, R3]
+        DSB
+
+        MOV     R0, #48             @ Opcode 48 (tipo_alg 0110)
+        BL      processar_imagem
+        POP     {PC}
+
         
 
 @ ========================================================================
@@ -420,13 +1152,46 @@ LW_BRIDGE_SPAN:
 
 @ Offsets dos componentes na ponte Lightweight
 IMAGE_MEM_OFFSET:
-        .word 0x0000            @ Offset da memória onchip
+        .word 0x0000            @ Offset da memória onchip (2 bancos de IMAGE_SIZE)
 
 CONFIG_PIO_OFFSET:
-        .word 0x8010            @ PIO de 10 bits
+        .word 0x18010           @ PIO de 10 bits
 
 RESET_PIO_OFFSET:
-        .word 0x8000            @ PIO de reset
+        .word 0x18000           @ PIO de reset
+
+STATUS_PIO_OFFSET:
+        .word 0x18020           @ PIO de status (entrada, 32 bits)
+
+VGA_PIO_OFFSET:
+        .word 0x18030           @ PIO do VGA (entrada, 32 bits)
+
+CURSOR_PIO_OFFSET:
+        .word 0x18040           @ Overlay: cursor
+
+JANELA_INI_PIO_OFFSET:
+        .word 0x18050           @ Overlay: modo e canto (x1, y1)
+
+JANELA_FIM_PIO_OFFSET:
+        .word 0x18060           @ Overlay: canto (x2, y2)
+
+LIMPEZA_PIO_OFFSET:
+        .word 0x18070           @ Ciclos da fase de limpeza (entrada, 32 bits)
+
+PASSO_X_PIO_OFFSET:
+        .word 0x18080           @ Escala DDA: passo horizontal 16.16
+
+PASSO_Y_PIO_OFFSET:
+        .word 0x18090           @ Escala DDA: passo vertical 16.16
+
+ROI_PIO_OFFSET:
+        .word 0x180A0           @ Região de interesse da imagem fonte
+
+CONTADOR_SEL_PIO_OFFSET:
+        .word 0x180B0           @ Índice do contador de desempenho
+
+CONTADOR_PIO_OFFSET:
+        .word 0x180C0           @ Valor do contador selecionado (entrada, 32 bits)
 
 @ Dimensões da imagem
 IMAGE_WIDTH:
@@ -444,3 +1209,16 @@ FPGA_VIRTUAL_ADDR:
 
 FILE_DESCRIPTOR:
         .space 4
+
+@ Bancos da imagem fonte (ping-pong)
+BANCO_CARGA:
+        .word 1                 @ Banco que recebe as cargas
+
+BANCO_ALU:
+        .word 0                 @ Banco lido pela ALU no último start
+
+CARGA_PENDENTE:
+        .word 0                 @ Houve carga desde o último start
+
+ENDERECO_CARGA:
+        .space 4                @ Endereço virtual do banco de carga
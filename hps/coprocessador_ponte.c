@@ -0,0 +1,539 @@
+// ========================================================================
+// coprocessador_ponte.c
+// Backend em C da API do coprocessador para execução fora da placa
+//
+// Implementa as mesmas funções de coprocessador.s, mas em vez de mapear
+// /dev/mem mapeia um arquivo (por padrão em /dev/shm) que faz o papel da
+// ponte Lightweight. Outro processo pode abrir o mesmo arquivo para
+// observar ou injetar o estado da "placa".
+//
+// Compilado com -DCOPROCESSADOR_MODELO, o pulso de start executa o modelo
+// da ALU (alu_modelo.c) e o framebuffer 640x480 resultante fica no mesmo
+// arquivo, logo após a janela da ponte.
+// ========================================================================
+
+#include "coprocessador.h"
+#include "mapa_ponte.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#ifdef COPROCESSADOR_MODELO
+#include "alu_modelo.h"
+#define TAMANHO_MAPEAMENTO (LW_BRIDGE_SPAN + FB_SIZE)
+#else
+#define TAMANHO_MAPEAMENTO LW_BRIDGE_SPAN
+#endif
+
+#define CAMINHO_PONTE_PADRAO "/dev/shm/coprocessador_ponte"
+
+// Temporização 640x480@60 do vga_driver: 800x525 pixels a 25 MHz
+#define VGA_QUADRO_US       16800           // 525 linhas de 32 us
+#define VGA_VBLANK_US       1440            // 45 linhas fora da área visível
+
+#ifdef COPROCESSADOR_MODELO
+// contadores_alu vê o start por 3 flip-flops: a latência conta o pulso de
+// reset da ALU menos esse atraso, além dos ciclos da operação
+#define PULSO_START_CICLOS  4               // mesmo pulso de tb_alu.v
+#define ATRASO_SINCRONIZADOR 3
+#endif
+
+// Variáveis de controle (equivalentes a FPGA_VIRTUAL_ADDR/FILE_DESCRIPTOR)
+static volatile unsigned char *fpga_virtual_addr = NULL;
+static int file_descriptor = -1;
+
+// Bancos da imagem fonte (equivalentes a BANCO_CARGA/BANCO_ALU/CARGA_PENDENTE)
+static int banco_carga = 1;
+static int banco_alu = 0;
+static int carga_pendente = 0;
+
+// Banco de contadores de desempenho (contadores_alu.v), atualizado a cada
+// start; pio_contador mostra a entrada escolhida por pio_contador_sel
+static unsigned int contadores[TOTAL_CONTADORES];
+static int em_execucao = 0;
+
+// ========================================================================
+// INICIALIZAÇÃO E CONTROLE
+// ========================================================================
+
+void iniciar_coprocessador(void)
+{
+    const char *caminho = getenv("COPROCESSADOR_PONTE");
+    if (!caminho || caminho[0] == '\0')
+    {
+        caminho = CAMINHO_PONTE_PADRAO;
+    }
+
+    file_descriptor = open(caminho, O_RDWR | O_CREAT, 0666);
+    if (file_descriptor < 0)
+    {
+        fprintf(stderr, "ERRO: Não foi possível abrir a ponte '%s'\n", caminho);
+        exit(1);
+    }
+
+    if (ftruncate(file_descriptor, TAMANHO_MAPEAMENTO) != 0)
+    {
+        fprintf(stderr, "ERRO: Falha ao dimensionar a ponte '%s'\n", caminho);
+        close(file_descriptor);
+        exit(1);
+    }
+
+    void *base = mmap(NULL, TAMANHO_MAPEAMENTO, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, file_descriptor, 0);
+    if (base == MAP_FAILED)
+    {
+        fprintf(stderr, "ERRO: Falha ao mapear a ponte '%s'\n", caminho);
+        close(file_descriptor);
+        exit(1);
+    }
+
+    fpga_virtual_addr = (volatile unsigned char *)base;
+    banco_carga = 1;
+    banco_alu = 0;
+    carga_pendente = 0;
+
+    /* Ponte recém-criada: como na placa após a configuração, a ALU está parada */
+    if (*(volatile unsigned int *)(fpga_virtual_addr + STATUS_PIO_OFFSET) == 0)
+        *(volatile unsigned int *)(fpga_virtual_addr + STATUS_PIO_OFFSET) = STATUS_CONCLUIDO;
+}
+
+void encerrar_coprocessador(void)
+{
+    munmap((void *)fpga_virtual_addr, TAMANHO_MAPEAMENTO);
+    close(file_descriptor);
+    fpga_virtual_addr = NULL;
+    file_descriptor = -1;
+}
+
+// ========================================================================
+// TRANSFERÊNCIA DE DADOS
+// ========================================================================
+
+/*
+ * As estratégias reproduzem o padrão de acesso das versões Assembly
+ * (largura e alinhamento de cada escrita no destino), não as instruções
+ */
+
+/* Banco que recebe a carga; marca a troca no próximo processar_imagem */
+static volatile unsigned char *memoria_carga(void)
+{
+    carga_pendente = 1;
+    return fpga_virtual_addr + IMAGE_MEM_OFFSET + banco_carga * IMAGE_SIZE;
+}
+
+void carregar_imagem(unsigned char *buffer_hps, int tamanho)
+{
+    carregar_imagem_neon(buffer_hps, tamanho);
+}
+
+void carregar_imagem_bytes(unsigned char *buffer_hps, int tamanho)
+{
+    volatile unsigned char *destino = memoria_carga();
+    int i;
+
+    for (i = 0; i < tamanho; i++)
+    {
+        destino[i] = buffer_hps[i];
+    }
+    __sync_synchronize();
+}
+
+void carregar_imagem_words(unsigned char *buffer_hps, int tamanho)
+{
+    volatile unsigned char *destino = memoria_carga();
+    int i = 0;
+
+    /* Só usa words se origem e destino estiverem alinhados */
+    if ((((uintptr_t)buffer_hps | (uintptr_t)destino) & 3) == 0)
+    {
+        for (; i + 4 <= tamanho; i += 4)
+        {
+            *(volatile uint32_t *)(destino + i) = *(uint32_t *)(buffer_hps + i);
+        }
+    }
+    for (; i < tamanho; i++)
+    {
+        destino[i] = buffer_hps[i];
+    }
+    __sync_synchronize();
+}
+
+/* Cabeça byte a byte até o destino alinhar, corpo em blocos, cauda em words/bytes */
+static void carregar_em_blocos(unsigned char *buffer_hps, int tamanho,
+                               int alinhamento, int bloco)
+{
+    volatile unsigned char *destino = memoria_carga();
+    uint32_t word;
+    int i = 0;
+
+    while (i < tamanho && ((uintptr_t)(destino + i) & (alinhamento - 1)))
+    {
+        destino[i] = buffer_hps[i];
+        i++;
+    }
+    for (; i + bloco <= tamanho; i += bloco)
+    {
+        memcpy((void *)(destino + i), buffer_hps + i, bloco);
+    }
+    for (; i + 4 <= tamanho; i += 4)
+    {
+        memcpy(&word, buffer_hps + i, 4);
+        *(volatile uint32_t *)(destino + i) = word;
+    }
+    for (; i < tamanho; i++)
+    {
+        destino[i] = buffer_hps[i];
+    }
+    __sync_synchronize();
+}
+
+void carregar_imagem_ldm(unsigned char *buffer_hps, int tamanho)
+{
+    carregar_em_blocos(buffer_hps, tamanho, 4, 32);
+}
+
+void carregar_imagem_neon(unsigned char *buffer_hps, int tamanho)
+{
+    carregar_em_blocos(buffer_hps, tamanho, 16, 64);
+}
+
+void carregar_regiao(unsigned char *buffer_hps, int x, int y,
+                     int largura, int altura, int stride)
+{
+    volatile unsigned char *banco = memoria_carga();
+    volatile unsigned char *destino;
+    unsigned char *origem;
+    uint32_t word;
+    int linha, i;
+
+    /* Recorte aos limites da imagem */
+    if (x < 0)
+    {
+        largura += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        altura += y;
+        y = 0;
+    }
+    if (largura > IMAGE_WIDTH - x)
+        largura = IMAGE_WIDTH - x;
+    if (altura > IMAGE_HEIGHT - y)
+        altura = IMAGE_HEIGHT - y;
+    if (largura <= 0 || altura <= 0)
+        return;
+
+    for (linha = 0; linha < altura; linha++)
+    {
+        origem = buffer_hps + (y + linha) * stride + x;
+        destino = banco + (y + linha) * IMAGE_WIDTH + x;
+        i = 0;
+
+        /* Mesmo padrão da versão Assembly: bytes, words alinhadas, bytes */
+        while (i < largura && ((uintptr_t)(destino + i) & 3))
+        {
+            destino[i] = origem[i];
+            i++;
+        }
+        for (; i + 4 <= largura; i += 4)
+        {
+            memcpy(&word, origem + i, 4);
+            *(volatile uint32_t *)(destino + i) = word;
+        }
+        for (; i < largura; i++)
+        {
+            destino[i] = origem[i];
+        }
+    }
+    __sync_synchronize();
+}
+
+void limpar_imagem(void)
+{
+    memset((void *)(fpga_virtual_addr + IMAGE_MEM_OFFSET), 0, 2 * IMAGE_SIZE);
+    __sync_synchronize();
+}
+
+// ========================================================================
+// FUNÇÕES AUXILIARES INTERNAS
+// ========================================================================
+
+static volatile unsigned int *registrador(int offset)
+{
+    return (volatile unsigned int *)(fpga_virtual_addr + offset);
+}
+
+static void escrever_config(int valor_config)
+{
+    *registrador(CONFIG_PIO_OFFSET) = valor_config & 0x3FF;
+    __sync_synchronize();
+}
+
+static void enviar_start(void)
+{
+    /* Start antes do done: a operação anterior nunca termina */
+    if (em_execucao)
+        contadores[CONTADOR_ABORTADAS]++;
+
+    *registrador(RESET_PIO_OFFSET) = 1;
+    __sync_synchronize();
+    *registrador(RESET_PIO_OFFSET) = 0;
+    __sync_synchronize();
+
+#ifdef COPROCESSADOR_MODELO
+    /* Borda de descida do reset: a FSM parte de S_IDLE */
+    int config = *registrador(CONFIG_PIO_OFFSET);
+    int banco = (config & CONFIG_BANCO) ? 1 : 0;
+    unsigned int passo_x = *registrador(PASSO_X_PIO_OFFSET);
+    unsigned int passo_y = *registrador(PASSO_Y_PIO_OFFSET);
+    unsigned int roi = *registrador(ROI_PIO_OFFSET);
+    unsigned int ciclos = alu_modelo_ciclos(config, passo_x, passo_y, roi);
+    unsigned int ciclos_limpeza = alu_modelo_ciclos_limpeza(config, roi);
+
+    alu_modelo_executar(config, passo_x, passo_y, roi,
+                        (const unsigned char *)(fpga_virtual_addr + IMAGE_MEM_OFFSET +
+                                                banco * IMAGE_SIZE),
+                        modelo_framebuffer());
+
+    /* O modelo termina na hora; o status reflete o que a FSM reportaria */
+    if (ciclos)
+        *registrador(STATUS_PIO_OFFSET) = (ciclos << STATUS_CICLOS_SHIFT) | STATUS_CONCLUIDO;
+    else
+        *registrador(STATUS_PIO_OFFSET) = STATUS_OCUPADO;
+    *registrador(LIMPEZA_PIO_OFFSET) = ciclos_limpeza;
+
+    contadores[CONTADOR_CICLOS] = ciclos;
+    contadores[CONTADOR_LIMPEZA] = ciclos_limpeza;
+    alu_modelo_acessos(config, passo_x, passo_y, roi,
+                       &contadores[CONTADOR_LEITURAS_ROM],
+                       &contadores[CONTADOR_ESCRITAS_FB]);
+    if (ciclos)
+        contadores[CONTADOR_LATENCIA] = ciclos + PULSO_START_CICLOS - ATRASO_SINCRONIZADOR;
+    else
+        contadores[CONTADOR_LATENCIA] = 0;
+    em_execucao = (ciclos == 0);
+    if (!em_execucao)
+        contadores[CONTADOR_CONCLUIDAS]++;
+#else
+    /* Sem ALU do outro lado: a operação conclui imediatamente */
+    *registrador(STATUS_PIO_OFFSET) = STATUS_CONCLUIDO;
+    *registrador(LIMPEZA_PIO_OFFSET) = 0;
+    contadores[CONTADOR_CONCLUIDAS]++;
+#endif
+    __sync_synchronize();
+}
+
+#ifdef COPROCESSADOR_MODELO
+unsigned char *modelo_framebuffer(void)
+{
+    if (!fpga_virtual_addr)
+        return NULL;
+    return (unsigned char *)(fpga_virtual_addr + LW_BRIDGE_SPAN);
+}
+#endif
+
+void processar_imagem(int operacao)
+{
+    operacao &= ~CONFIG_BANCO;
+
+    /* Nova carga: a ALU passa a ler o banco carregado e as cargas trocam */
+    if (carga_pendente)
+    {
+        carga_pendente = 0;
+        banco_alu = banco_carga;
+        banco_carga ^= 1;
+    }
+
+    escrever_config(operacao | (banco_alu ? CONFIG_BANCO : 0));
+    enviar_start();
+}
+
+int coprocessador_banco_carga(void)
+{
+    return banco_carga;
+}
+
+// ========================================================================
+// STATUS DA ALU
+// ========================================================================
+
+int coprocessador_ocupado(void)
+{
+    return (*registrador(STATUS_PIO_OFFSET) & STATUS_OCUPADO) ? 1 : 0;
+}
+
+unsigned int coprocessador_ciclos(void)
+{
+    return *registrador(STATUS_PIO_OFFSET) >> STATUS_CICLOS_SHIFT;
+}
+
+unsigned int coprocessador_ciclos_limpeza(void)
+{
+    return *registrador(LIMPEZA_PIO_OFFSET);
+}
+
+static unsigned int ler_tempo_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned int)ts.tv_sec * 1000000u + (unsigned int)(ts.tv_nsec / 1000);
+}
+
+int aguardar_conclusao(int timeout_us)
+{
+    unsigned int inicio = ler_tempo_us();
+
+    while (!(*registrador(STATUS_PIO_OFFSET) & STATUS_CONCLUIDO))
+    {
+        if (timeout_us >= 0 && ler_tempo_us() - inicio >= (unsigned int)timeout_us)
+            return -1;
+    }
+    return 0;
+}
+
+// ========================================================================
+// CONTADORES DE DESEMPENHO
+// ========================================================================
+
+void coprocessador_ler_contadores(ContadoresCoprocessador *destino)
+{
+    unsigned int *campo = (unsigned int *)destino;
+    int i;
+
+    for (i = 0; i < TOTAL_CONTADORES; i++)
+    {
+        *registrador(CONTADOR_SEL_PIO_OFFSET) = i;
+        __sync_synchronize();
+
+        /* O multiplexador de contadores_alu.v */
+        *registrador(CONTADOR_PIO_OFFSET) = contadores[i];
+        campo[i] = *registrador(CONTADOR_PIO_OFFSET);
+    }
+}
+
+// ========================================================================
+// SINCRONISMO DO VGA
+// ========================================================================
+
+/* Sem VGA do outro lado: o PIO segue a temporização do vga_driver pelo
+ * relógio do sistema, com o quadro começando no vblank */
+static unsigned int ler_pio_vga(void)
+{
+    struct timespec ts;
+    unsigned long long agora_us;
+    unsigned int valor;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    agora_us = (unsigned long long)ts.tv_sec * 1000000ull + ts.tv_nsec / 1000;
+
+    valor = (unsigned int)(agora_us / VGA_QUADRO_US) << VGA_QUADRO_SHIFT;
+    if (agora_us % VGA_QUADRO_US < VGA_VBLANK_US)
+        valor |= VGA_VBLANK;
+
+    *registrador(VGA_PIO_OFFSET) = valor;
+    return valor;
+}
+
+unsigned int coprocessador_quadro(void)
+{
+    return ler_pio_vga() >> VGA_QUADRO_SHIFT;
+}
+
+int coprocessador_em_vblank(void)
+{
+    return (ler_pio_vga() & VGA_VBLANK) ? 1 : 0;
+}
+
+// ========================================================================
+// OVERLAY DO VGA
+// ========================================================================
+
+/* Só os registradores: o overlay atua depois do framebuffer, então nem o
+ * modelo o desenha em modelo_framebuffer() */
+static unsigned int coordenadas_overlay(int x, int y)
+{
+    return ((unsigned int)y & OVERLAY_COORD_MASK) << OVERLAY_Y_SHIFT |
+           ((unsigned int)x & OVERLAY_COORD_MASK);
+}
+
+void overlay_cursor(int x, int y, int visivel)
+{
+    *registrador(CURSOR_PIO_OFFSET) = coordenadas_overlay(x, y) |
+                                      (visivel ? OVERLAY_VISIVEL : 0);
+    __sync_synchronize();
+}
+
+void overlay_janela(int modo, int x1, int y1, int x2, int y2)
+{
+    /* Fim primeiro: o modo em janela_ini só ativa com as duas pontas prontas */
+    *registrador(JANELA_FIM_PIO_OFFSET) = coordenadas_overlay(x2, y2);
+    *registrador(JANELA_INI_PIO_OFFSET) = coordenadas_overlay(x1, y1) |
+                                          ((unsigned int)(modo & 3) << OVERLAY_MODO_SHIFT);
+    __sync_synchronize();
+}
+
+// ========================================================================
+// REGIÃO DE INTERESSE
+// ========================================================================
+
+void coprocessador_roi(int x, int y, int largura, int altura)
+{
+    unsigned int valor = 0;
+
+    /* Recorte aos limites da imagem, como em carregar_regiao */
+    if (x < 0)
+    {
+        largura += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        altura += y;
+        y = 0;
+    }
+    if (largura > IMAGE_WIDTH - x)
+        largura = IMAGE_WIDTH - x;
+    if (altura > IMAGE_HEIGHT - y)
+        altura = IMAGE_HEIGHT - y;
+
+    if (largura > 0 && altura > 0)
+    {
+        valor = ROI_ATIVA |
+                (unsigned int)altura << ROI_ALT_SHIFT |
+                (unsigned int)largura << ROI_LARG_SHIFT |
+                (unsigned int)y << ROI_Y_SHIFT | (unsigned int)x;
+    }
+
+    *registrador(ROI_PIO_OFFSET) = valor;
+    __sync_synchronize();
+}
+
+// ========================================================================
+// FUNÇÕES DA ISA
+// ========================================================================
+
+void api_bypass(void)        { processar_imagem(0); }
+void api_media_0_5x(void)    { processar_imagem(11); }
+void api_media_0_25x(void)   { processar_imagem(12); }
+void api_vizinho_2x(void)    { processar_imagem(17); }
+void api_vizinho_4x(void)    { processar_imagem(18); }
+void api_vizinho_0_5x(void)  { processar_imagem(27); }
+void api_vizinho_0_25x(void) { processar_imagem(28); }
+void api_replicacao_2x(void) { processar_imagem(33); }
+void api_replicacao_4x(void) { processar_imagem(34); }
+void api_bilinear_2x(void)   { processar_imagem(41); }
+void api_bilinear_4x(void)   { processar_imagem(42); }
+
+void api_escala(unsigned int passo_x, unsigned int passo_y)
+{
+    *registrador(PASSO_X_PIO_OFFSET) = passo_x;
+    *registrador(PASSO_Y_PIO_OFFSET) = passo_y;
+    __sync_synchronize();
+    processar_imagem(48);
+}
@@ -2,26 +2,57 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <linux/input.h>
 #include <termios.h>
-#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/stat.h>
 #include "coprocessador.h"
 #include "bitmap.h"
+#include "pacote.h"
+#include "cache_imagens.h"
+#include "alocacoes.h"
 
 #define IMG_WIDTH 160
 #define IMG_HEIGHT 120
 #define IMG_SIZE (IMG_WIDTH * IMG_HEIGHT)
 
-/* Parâmetros visuais do cursor e retângulo */
-#define CURSOR_SIZE 5
-#define CURSOR_COLOR 255      /* Branco */
-#define CURSOR_BORDER_COLOR 0 /* Preto para contraste */
-#define RECT_THICKNESS 2
-#define RECT_COLOR 255 /* Branco */
+/* Posição da imagem 1x (bypass) na tela 640x480, onde o overlay desenha */
+#define TELA_OFFSET_X ((640 - IMG_WIDTH) / 2)
+#define TELA_OFFSET_Y ((480 - IMG_HEIGHT) / 2)
+
+/* Canto animado do primeiro ponto da seleção */
 #define CORNER_SIZE 8
 
+/* Tempo máximo de espera pela ALU (a operação mais longa leva ~27 ms) */
+#define TIMEOUT_ALU_US 100000
+
+/* Laço de eventos: animação do primeiro canto e duração de um quadro VGA
+ * (525 linhas de 32 us), usada para dormir até o próximo quadro com
+ * movimento pendente */
+#define PERIODO_ANIMACAO_MS 500
+#define PERIODO_QUADRO_US 16800
+
+/* Arena de quadros: buffers de IMG_SIZE alinhados à linha de cache */
+#define ALINHAMENTO_QUADRO 64
+
+/* Orçamento do cache de BMPs decodificados (variável CACHE_IMAGENS_KB;
+ * 0 desliga): 1 MB guarda 54 imagens */
+#define CACHE_IMAGENS_KB_PADRAO 1024
+
+/* Limites do zoom na tela 640x480 */
+#define ZOOM_MINIMO 0.25f
+#define ZOOM_MAXIMO 4.0f
+
+/* Níveis de [ e ]: os fatores fora das potências de 2 usam a escala DDA */
+static const float niveis_zoom_fino[] = {0.25f, 0.5f, 0.75f, 1.0f, 1.5f, 2.0f, 3.0f, 4.0f};
+#define TOTAL_NIVEIS_FINOS (int)(sizeof(niveis_zoom_fino) / sizeof(niveis_zoom_fino[0]))
+
 /* Estrutura para região de zoom */
 typedef struct
 {
@@ -42,12 +73,17 @@ typedef enum
 /* Estado global da aplicação */
 typedef struct
 {
-    unsigned char *imagem_original;
-    unsigned char *imagem_atual;
+    unsigned char *imagem_original;     /* Último BMP carregado sem cache (arena) */
+    const unsigned char *imagem_atual;  /* imagem_original, do cache ou do pacote */
+    Pacote pacote;                      /* Pacote mapeado (base NULL = nenhum) */
+    int quadro_pacote;                  /* Quadro exibido, -1 = BMP */
+    CacheImagens cache;                 /* BMPs já decodificados */
     JanelaZoom janela;
     TipoAlgoritmo algoritmo;
     float nivel_zoom; /* 1.0 = original, 2.0 = 2x, 0.5 = 0.5x */
     int mouse_x, mouse_y;
+    int fase_canto;           /* Animação do primeiro canto da janela */
+    int fpga_sincronizada[2]; /* Banco da FPGA contém imagem_atual */
 } EstadoApp;
 
 /* ========================================================================
@@ -70,143 +106,127 @@ void restaurar_terminal()
     tcsetattr(STDIN_FILENO, TCSANOW, &original_term);
 }
 
-int tecla_disponivel()
-{
-    struct timeval tv = {0, 0};
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(STDIN_FILENO, &fds);
-    return select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) > 0;
-}
-
 /* ========================================================================
-   FUNÇÕES DE DESENHO - CURSOR E RETÂNGULO NO BUFFER
+   LAÇO DE EVENTOS (epoll)
    ======================================================================== */
 
-/* Desenha linha horizontal no buffer */
-void desenhar_linha_horizontal(unsigned char *buffer, int x1, int x2, int y,
-                               int largura, int altura, unsigned char cor)
+/* Registra um descritor no epoll para leitura */
+int registrar_evento(int epoll_fd, int fd)
 {
-    int x;
-    if (y < 0 || y >= altura)
-        return;
-
-    int start = (x1 < 0) ? 0 : x1;
-    int end = (x2 >= largura) ? largura - 1 : x2;
-
-    for (x = start; x <= end; x++)
-    {
-        buffer[y * largura + x] = cor;
-    }
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
 }
 
-/* Desenha linha vertical no buffer */
-void desenhar_linha_vertical(unsigned char *buffer, int x, int y1, int y2,
-                             int largura, int altura, unsigned char cor)
+/* Liga (periodo_ms > 0) ou desliga (0) o timer periódico */
+void programar_timer(int timer_fd, int periodo_ms)
 {
-    int y;
-    if (x < 0 || x >= largura)
-        return;
-
-    int start = (y1 < 0) ? 0 : y1;
-    int end = (y2 >= altura) ? altura - 1 : y2;
-
-    for (y = start; y <= end; y++)
-    {
-        buffer[y * largura + x] = cor;
-    }
+    struct itimerspec t;
+    memset(&t, 0, sizeof(t));
+    t.it_interval.tv_sec = periodo_ms / 1000;
+    t.it_interval.tv_nsec = (periodo_ms % 1000) * 1000000L;
+    t.it_value = t.it_interval;
+    timerfd_settime(timer_fd, 0, &t, NULL);
 }
 
-/* Desenha cursor em forma de cruz com borda para visibilidade */
-void desenhar_cursor(unsigned char *buffer, int mouse_x, int mouse_y,
-                     int largura, int altura)
+/* Relógio monotônico em microssegundos */
+long long agora_us(void)
 {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
 
-    /* Cruz com borda preta para ser visível em qualquer fundo */
-
-    /* Linha horizontal (com borda) */
-    desenhar_linha_horizontal(buffer, mouse_x - CURSOR_SIZE, mouse_x + CURSOR_SIZE,
-                              mouse_y - 1, largura, altura, CURSOR_BORDER_COLOR);
-    desenhar_linha_horizontal(buffer, mouse_x - CURSOR_SIZE, mouse_x + CURSOR_SIZE,
-                              mouse_y, largura, altura, CURSOR_COLOR);
-    desenhar_linha_horizontal(buffer, mouse_x - CURSOR_SIZE, mouse_x + CURSOR_SIZE,
-                              mouse_y + 1, largura, altura, CURSOR_BORDER_COLOR);
-
-    /* Linha vertical (com borda) */
-    desenhar_linha_vertical(buffer, mouse_x - 1, mouse_y - CURSOR_SIZE,
-                            mouse_y + CURSOR_SIZE, largura, altura, CURSOR_BORDER_COLOR);
-    desenhar_linha_vertical(buffer, mouse_x, mouse_y - CURSOR_SIZE,
-                            mouse_y + CURSOR_SIZE, largura, altura, CURSOR_COLOR);
-    desenhar_linha_vertical(buffer, mouse_x + 1, mouse_y - CURSOR_SIZE,
-                            mouse_y + CURSOR_SIZE, largura, altura, CURSOR_BORDER_COLOR);
+/* Milissegundos até o fim do quadro que começou (ou foi visto pela
+ * primeira vez) em instante_quadro_us. Nunca devolve 0: se o contador
+ * atrasar em relação ao relógio, a próxima espera é curta mas não gira */
+int espera_proximo_quadro_ms(long long instante_quadro_us)
+{
+    long long restante = PERIODO_QUADRO_US - (agora_us() - instante_quadro_us);
+    if (restante < 1000)
+        return 1;
+    return (int)((restante + 999) / 1000);
 }
 
-/* Desenha retângulo de seleção */
-void desenhar_retangulo(unsigned char *buffer, int x1, int y1, int x2, int y2,
-                        int largura, int altura)
+/* ========================================================================
+   OVERLAY DO VGA - CURSOR E JANELA DE SELEÇÃO
+   ======================================================================== */
+
+/* Cursor e janela são desenhados pelo hardware sobre a imagem 1x
+ * centralizada na tela; não entram na imagem enviada à FPGA. Nos outros
+ * zooms a tela não corresponde às coordenadas do mouse e o overlay some */
+void atualizar_overlay(EstadoApp *estado)
 {
-    int i;
+    int visivel = (estado->nivel_zoom == 1.0f);
+    int x1 = TELA_OFFSET_X + estado->janela.x1;
+    int y1 = TELA_OFFSET_Y + estado->janela.y1;
 
-    /* Normalizar coordenadas (garantir x1 < x2 e y1 < y2) */
-    if (x1 > x2)
+    overlay_cursor(TELA_OFFSET_X + estado->mouse_x,
+                   TELA_OFFSET_Y + estado->mouse_y, visivel);
+
+    if (!visivel || estado->janela.pontos_definidos == 0)
+    {
+        overlay_janela(OVERLAY_OCULTO, 0, 0, 0, 0);
+    }
+    else if (estado->janela.pontos_definidos == 1)
     {
-        int temp = x1;
-        x1 = x2;
-        x2 = temp;
+        /* Canto em L que pulsa variando o tamanho dos braços */
+        int tamanho = CORNER_SIZE + (estado->fase_canto % 4);
+        overlay_janela(OVERLAY_CANTO, x1, y1, x1 + tamanho, y1 + tamanho);
     }
-    if (y1 > y2)
+    else
     {
-        int temp = y1;
-        y1 = y2;
-        y2 = temp;
+        overlay_janela(OVERLAY_RETANGULO, x1, y1,
+                       TELA_OFFSET_X + estado->janela.x2,
+                       TELA_OFFSET_Y + estado->janela.y2);
     }
+}
+
+/* ========================================================================
+   ENVIO DA IMAGEM À FPGA
+   ======================================================================== */
 
-    /* Desenhar bordas superior e inferior */
-    for (i = 0; i < RECT_THICKNESS; i++)
+/* Espera a ALU terminar a operação anterior antes de disparar outra */
+void aguardar_alu(void)
+{
+    if (aguardar_conclusao(TIMEOUT_ALU_US) != 0)
     {
-        desenhar_linha_horizontal(buffer, x1, x2, y1 + i,
-                                  largura, altura, RECT_COLOR);
-        desenhar_linha_horizontal(buffer, x1, x2, y2 - i,
-                                  largura, altura, RECT_COLOR);
+        printf("\nAVISO: ALU não concluiu a operação anterior em %d ms\n",
+               TIMEOUT_ALU_US / 1000);
     }
+}
 
-    /* Desenhar bordas esquerda e direita */
-    for (i = 0; i < RECT_THICKNESS; i++)
+/* Nova imagem_atual: nenhum banco da FPGA a contém mais */
+void invalidar_bancos(EstadoApp *estado)
+{
+    int b;
+    for (b = 0; b < 2; b++)
     {
-        desenhar_linha_vertical(buffer, x1 + i, y1, y2,
-                                largura, altura, RECT_COLOR);
-        desenhar_linha_vertical(buffer, x2 - i, y1, y2,
-                                largura, altura, RECT_COLOR);
+        estado->fpga_sincronizada[b] = 0;
     }
 }
 
-/* Desenha cantos animados quando apenas 1 ponto foi definido */
-void desenhar_cantos_animados(unsigned char *buffer, int x, int y,
-                              int largura, int altura, int fase)
+/* Envia imagem_atual à FPGA, a menos que o banco de carga já a contenha
+ * (o cursor e a janela vivem no overlay, então a imagem só muda com zoom
+ * de região ou nova imagem). A carga vai para o banco livre enquanto a ALU
+ * termina a operação anterior */
+void enviar_imagem_atual(EstadoApp *estado)
 {
-    /* Animar variando o tamanho com base na fase */
-    int tamanho = CORNER_SIZE + (fase % 4);
-
-    /* Canto em L invertido */
-    desenhar_linha_horizontal(buffer, x - 1, x + tamanho, y - 1,
-                              largura, altura, CURSOR_BORDER_COLOR);
-    desenhar_linha_horizontal(buffer, x, x + tamanho, y,
-                              largura, altura, CURSOR_COLOR);
-    desenhar_linha_horizontal(buffer, x - 1, x + tamanho, y + 1,
-                              largura, altura, CURSOR_BORDER_COLOR);
-
-    desenhar_linha_vertical(buffer, x - 1, y - 1, y + tamanho,
-                            largura, altura, CURSOR_BORDER_COLOR);
-    desenhar_linha_vertical(buffer, x, y, y + tamanho,
-                            largura, altura, CURSOR_COLOR);
-    desenhar_linha_vertical(buffer, x + 1, y - 1, y + tamanho,
-                            largura, altura, CURSOR_BORDER_COLOR);
-
-    /* Ponto central */
-    if (x >= 0 && x < largura && y >= 0 && y < altura)
+    int banco = coprocessador_banco_carga();
+    int bytes = 0;
+
+    if (!estado->fpga_sincronizada[banco])
     {
-        buffer[y * largura + x] = CURSOR_COLOR;
+        /* carregar_imagem só lê o buffer, que pode ser o mapeamento do pacote */
+        carregar_imagem((unsigned char *)estado->imagem_atual, IMG_SIZE);
+        estado->fpga_sincronizada[banco] = 1;
+        bytes = IMG_SIZE;
     }
+    printf("(%d bytes enviados) ", bytes);
+
+    aguardar_alu();
 }
 
 /* ========================================================================
@@ -230,53 +250,25 @@ void normalizar_janela(JanelaZoom *janela)
     }
 }
 
-void extrair_regiao(unsigned char *imagem_completa, unsigned char *regiao,
-                    int x1, int y1, int x2, int y2)
-{
-    int largura_regiao = x2 - x1;
-    int altura_regiao = y2 - y1;
-    int y, x;
+/* ========================================================================
+   VALIDAÇÃO DE ALGORITMO E ZOOM
+   ======================================================================== */
 
-    for (y = 0; y < altura_regiao; y++)
-    {
-        for (x = 0; x < largura_regiao; x++)
-        {
-            int src_x = x1 + x;
-            int src_y = y1 + y;
-            if (src_x >= 0 && src_x < IMG_WIDTH && src_y >= 0 && src_y < IMG_HEIGHT)
-            {
-                regiao[y * largura_regiao + x] =
-                    imagem_completa[src_y * IMG_WIDTH + src_x];
-            }
-        }
-    }
+/* Fatores com opcode próprio; os demais só existem na escala DDA */
+int zoom_potencia_de_2(float zoom)
+{
+    return zoom == 0.25f || zoom == 0.5f || zoom == 1.0f ||
+           zoom == 2.0f || zoom == 4.0f;
 }
 
-void sobrepor_regiao(unsigned char *imagem_base, unsigned char *regiao,
-                     int x1, int y1, int largura, int altura)
+int algoritmo_zoom_compativel(TipoAlgoritmo algoritmo, float zoom)
 {
-    int y, x;
-
-    for (y = 0; y < altura && (y1 + y) < IMG_HEIGHT; y++)
+    /* A escala DDA é vizinho mais próximo: Média e Replicação só nas potências de 2 */
+    if (algoritmo != ALG_VIZINHO_PROXIMO && !zoom_potencia_de_2(zoom))
     {
-        for (x = 0; x < largura && (x1 + x) < IMG_WIDTH; x++)
-        {
-            int dst_idx = (y1 + y) * IMG_WIDTH + (x1 + x);
-            int src_idx = y * largura + x;
-            if (dst_idx < IMG_SIZE)
-            {
-                imagem_base[dst_idx] = regiao[src_idx];
-            }
-        }
+        return 0;
     }
-}
 
-/* ========================================================================
-   VALIDAÇÃO DE ALGORITMO E ZOOM
-   ======================================================================== */
-
-int algoritmo_zoom_compativel(TipoAlgoritmo algoritmo, float zoom)
-{
     /* Algoritmo Média só funciona com redução (0.5x e 0.25x) */
     if (algoritmo == ALG_MEDIA && zoom > 1.0f)
     {
@@ -311,22 +303,106 @@ void ajustar_zoom_para_algoritmo(EstadoApp *estado)
     }
 }
 
+/* ========================================================================
+   ARENA DE QUADROS
+   ======================================================================== */
+
+/* Todos os buffers do tamanho de um quadro saem de um único bloco alocado
+ * na inicialização; o processamento de cada quadro não usa o alocador.
+ * IMG_SIZE é múltiplo de 64, então todo quadro começa numa linha de cache
+ * e satisfaz o alinhamento das rajadas LDM/NEON de carregar_imagem */
+typedef enum
+{
+    QUADRO_ORIGINAL,    /* imagem_original */
+    QUADRO_CARGA,       /* Nova imagem lida do disco */
+    TOTAL_QUADROS
+} QuadroArena;
+
+_Static_assert(IMG_SIZE % ALINHAMENTO_QUADRO == 0,
+               "IMG_SIZE deve preservar o alinhamento dos quadros");
+
+unsigned char *arena_quadros = NULL;
+
+int criar_arena_quadros(void)
+{
+    arena_quadros = (unsigned char *)aligned_alloc(ALINHAMENTO_QUADRO,
+                                                   TOTAL_QUADROS * IMG_SIZE);
+    if (!arena_quadros)
+        return -1;
+    memset(arena_quadros, 0, TOTAL_QUADROS * IMG_SIZE);
+    return 0;
+}
+
+void destruir_arena_quadros(void)
+{
+    free(arena_quadros);
+    arena_quadros = NULL;
+}
+
+unsigned char *quadro_arena(QuadroArena quadro)
+{
+    return arena_quadros + quadro * IMG_SIZE;
+}
+
+/* Cache de BMPs com o orçamento de CACHE_IMAGENS_KB, alocado uma vez */
+int criar_cache(EstadoApp *estado)
+{
+    const char *valor = getenv("CACHE_IMAGENS_KB");
+    unsigned long kb = CACHE_IMAGENS_KB_PADRAO;
+    char *fim;
+
+    if (valor && valor[0] != '\0')
+    {
+        kb = strtoul(valor, &fim, 10);
+        if (*fim != '\0')
+        {
+            fprintf(stderr, "AVISO: CACHE_IMAGENS_KB inválido, usando %d KB\n",
+                    CACHE_IMAGENS_KB_PADRAO);
+            kb = CACHE_IMAGENS_KB_PADRAO;
+        }
+    }
+    return criar_cache_imagens(&estado->cache, (size_t)kb * 1024, IMG_SIZE);
+}
+
+/* Imagem de um BMP, do cache se o arquivo não mudou desde a última leitura.
+ * A decodificação vai para a área de carga (a imagem em uso fica intacta se
+ * falhar) e o resultado para o cache, ou para imagem_original sem cache */
+const unsigned char *ler_bmp(EstadoApp *estado, const char *caminho)
+{
+    struct stat st;
+    int tem_stat = (stat(caminho, &st) == 0);
+
+    if (tem_stat)
+    {
+        const unsigned char *guardada = procurar_no_cache(&estado->cache, caminho, &st);
+        if (guardada)
+        {
+            printf(" Imagem no cache: nada lido do disco\n");
+            return guardada;
+        }
+    }
+
+    unsigned char *carga = quadro_arena(QUADRO_CARGA);
+    if (carregar_bitmap(caminho, carga, IMG_WIDTH, IMG_HEIGHT) != 0)
+        return NULL;
+
+    unsigned char *destino = tem_stat ? reservar_no_cache(&estado->cache, caminho, &st) : NULL;
+    if (!destino)
+        destino = estado->imagem_original;
+    memcpy(destino, carga, IMG_SIZE);
+    return destino;
+}
+
 /* ========================================================================
    PROCESSAMENTO COM ALGORITMO + OVERLAY VISUAL
    ======================================================================== */
 
 void processar_com_algoritmo(EstadoApp *estado)
 {
-    static int frame_counter = 0;
-    unsigned char *buffer_temporario = NULL;
-    unsigned char *regiao_extraida = NULL;
-    unsigned char *regiao_processada = NULL;
+    unsigned long alocacoes_inicio = alocacoes_realizadas();
 
     printf("\n[PROCESSAMENTO] Aplicando zoom %.2fx ", estado->nivel_zoom);
 
-    /* Copiar imagem original para buffer de trabalho */
-    memcpy(estado->imagem_atual, estado->imagem_original, IMG_SIZE);
-
     /* ====================================================================
        PROCESSAR APENAS A REGIÃO SELECIONADA (SE HOUVER)
        ==================================================================== */
@@ -339,41 +415,17 @@ void processar_com_algoritmo(EstadoApp *estado)
 
         int largura_janela = estado->janela.x2 - estado->janela.x1;
         int altura_janela = estado->janela.y2 - estado->janela.y1;
-        int tamanho_regiao = largura_janela * altura_janela;
 
         printf("na região (%d,%d) até (%d,%d) [%dx%d]\n",
                estado->janela.x1, estado->janela.y1,
                estado->janela.x2, estado->janela.y2,
                largura_janela, altura_janela);
 
-        /* Alocar buffers temporários */
-        regiao_extraida = (unsigned char *)malloc(tamanho_regiao);
-        buffer_temporario = (unsigned char *)malloc(IMG_SIZE);
-
-        if (!regiao_extraida || !buffer_temporario)
-        {
-            printf("ERRO: Falha ao alocar memória temporária\n");
-            goto cleanup;
-        }
-
-        /* 1. Extrair apenas a região selecionada */
-        extrair_regiao(estado->imagem_original, regiao_extraida,
-                       estado->janela.x1, estado->janela.y1,
-                       estado->janela.x2, estado->janela.y2);
-
-        /* 2. Criar imagem 160x120 com a região no centro (resto preto) */
-        memset(buffer_temporario, 0, IMG_SIZE);
-
-        /* Calcular posição para centralizar a região */
-        int offset_x = (IMG_WIDTH - largura_janela) / 2;
-        int offset_y = (IMG_HEIGHT - altura_janela) / 2;
-
-        /* Copiar região para o centro do buffer temporário */
-        sobrepor_regiao(buffer_temporario, regiao_extraida,
-                        offset_x, offset_y, largura_janela, altura_janela);
-
-        /* 3. Enviar buffer temporário para FPGA e processar */
-        carregar_imagem(buffer_temporario, IMG_SIZE);
+        /* A imagem inteira fica no banco; a ALU lê só a janela (pio_roi)
+         * e centraliza o resultado, sem recarregar a imagem */
+        enviar_imagem_atual(estado);
+        coprocessador_roi(estado->janela.x1, estado->janela.y1,
+                          largura_janela, altura_janela);
 
         /* Aplicar algoritmo com validação */
         if (estado->nivel_zoom == 2.0f)
@@ -448,30 +500,17 @@ void processar_com_algoritmo(EstadoApp *estado)
                 api_vizinho_0_25x();
             }
         }
-
-    /* Liberar buffers temporários */
-    cleanup:
-        if (regiao_extraida)
-            free(regiao_extraida);
-        if (buffer_temporario)
-            free(buffer_temporario);
-
-        /* Desenhar overlays na imagem original (para feedback visual) */
-        desenhar_retangulo(estado->imagem_atual,
-                           estado->janela.x1, estado->janela.y1,
-                           estado->janela.x2, estado->janela.y2,
-                           IMG_WIDTH, IMG_HEIGHT);
+        else
+        {
+            printf("Algoritmo: Escala DDA %.2fX (região)\n", estado->nivel_zoom);
+            api_escala(PASSO_ESCALA(estado->nivel_zoom), PASSO_ESCALA(estado->nivel_zoom));
+        }
     }
     else
     {
         /* SEM JANELA SELECIONADA ou ZOOM 1X - processar imagem completa */
-
         if (estado->janela.pontos_definidos == 1)
         {
-            /* Desenhar apenas o primeiro canto com animação */
-            desenhar_cantos_animados(estado->imagem_atual,
-                                     estado->janela.x1, estado->janela.y1,
-                                     IMG_WIDTH, IMG_HEIGHT, frame_counter++);
             printf("(aguardando segundo ponto)\n");
         }
         else
@@ -479,13 +518,9 @@ void processar_com_algoritmo(EstadoApp *estado)
             printf("na imagem completa\n");
         }
 
-        /* Desenhar cursor */
-        desenhar_cursor(estado->imagem_atual,
-                        estado->mouse_x, estado->mouse_y,
-                        IMG_WIDTH, IMG_HEIGHT);
-
-        /* Carregar e processar imagem completa */
-        carregar_imagem(estado->imagem_atual, IMG_SIZE);
+        /* Enviar a imagem (se o banco não a tiver) e processar */
+        enviar_imagem_atual(estado);
+        coprocessador_roi(0, 0, 0, 0);
 
         if (estado->nivel_zoom == 1.0f)
         {
@@ -564,11 +599,71 @@ void processar_com_algoritmo(EstadoApp *estado)
                 api_vizinho_0_25x();
             }
         }
+        else
+        {
+            printf("Algoritmo: Escala DDA %.2fX\n", estado->nivel_zoom);
+            api_escala(PASSO_ESCALA(estado->nivel_zoom), PASSO_ESCALA(estado->nivel_zoom));
+        }
     }
 
+    /* Cursor e janela acompanham o novo zoom/seleção */
+    atualizar_overlay(estado);
+
+    /* Regime permanente: nenhum quadro passa pelo alocador */
+    assert(alocacoes_realizadas() == alocacoes_inicio);
+
     printf("[OK] Processamento concluído!\n");
 }
 
+/* Exibe uma imagem recém-escolhida: estado resetado e carga direta na FPGA */
+void exibir_nova_imagem(EstadoApp *estado)
+{
+    estado->janela.pontos_definidos = 0;
+    estado->janela.ativo = 0;
+    estado->nivel_zoom = 1.0f;
+    estado->algoritmo = ALG_VIZINHO_PROXIMO;
+
+    printf(" Estado resetado (Zoom 1x, Algoritmo Vizinho Próximo)\n");
+
+    invalidar_bancos(estado);
+    estado->fpga_sincronizada[coprocessador_banco_carga()] = 1;
+    carregar_imagem((unsigned char *)estado->imagem_atual, IMG_SIZE);
+    aguardar_alu();
+    coprocessador_roi(0, 0, 0, 0);
+    api_bypass();
+    atualizar_overlay(estado);
+}
+
+/* Troca para um quadro do pacote: só muda o ponteiro, sem ler nem copiar */
+void selecionar_quadro_pacote(EstadoApp *estado, int indice)
+{
+    estado->quadro_pacote = indice;
+    estado->imagem_atual = pacote_quadro(&estado->pacote, indice);
+    printf("\n Quadro %d/%d do pacote: %s\n", indice + 1, estado->pacote.total,
+           estado->pacote.entradas[indice].nome);
+}
+
+/* Mapeia um novo pacote no lugar do atual e seleciona o primeiro quadro */
+int abrir_novo_pacote(EstadoApp *estado, const char *caminho)
+{
+    Pacote novo;
+
+    if (abrir_pacote(&novo, caminho) != 0)
+        return -1;
+    if (novo.total == 0)
+    {
+        fprintf(stderr, "ERRO: Pacote '%s' vazio\n", caminho);
+        fechar_pacote(&novo);
+        return -1;
+    }
+
+    fechar_pacote(&estado->pacote);
+    estado->pacote = novo;
+    printf(" Pacote com %d quadro(s) mapeado\n", novo.total);
+    selecionar_quadro_pacote(estado, 0);
+    return 0;
+}
+
 int carregar_nova_imagem(EstadoApp *estado)
 {
     char caminho[256];
@@ -576,7 +671,14 @@ int carregar_nova_imagem(EstadoApp *estado)
     printf("\n╔════════════════════════════════════════════════════════╗\n");
     printf("║           CARREGAR NOVA IMAGEM BMP                    ║\n");
     printf("╚════════════════════════════════════════════════════════╝\n");
-    printf("\nDigite o caminho do arquivo BMP: ");
+    if (estado->pacote.base)
+    {
+        printf("\nDigite o caminho do arquivo BMP/pacote ou o nome de um quadro: ");
+    }
+    else
+    {
+        printf("\nDigite o caminho do arquivo BMP ou pacote: ");
+    }
     fflush(stdout);
 
     /* Restaurar terminal para ler linha */
@@ -601,41 +703,44 @@ int carregar_nova_imagem(EstadoApp *estado)
         return 0;
     }
 
+    /* Quadro do pacote aberto: nada a ler do disco */
+    int indice = estado->pacote.base ? procurar_no_pacote(&estado->pacote, caminho) : -1;
+    if (indice >= 0)
+    {
+        selecionar_quadro_pacote(estado, indice);
+        exibir_nova_imagem(estado);
+        return 1;
+    }
+
     printf("\n Carregando: %s\n", caminho);
 
-    /* Tentar carregar nova imagem em buffer temporário */
-    unsigned char *temp_buffer = (unsigned char *)malloc(IMG_SIZE);
-    if (!temp_buffer)
+    if (e_pacote(caminho))
     {
-        printf(" ERRO: Falha ao alocar memória temporária\n");
-        return 0;
+        if (abrir_novo_pacote(estado, caminho) != 0)
+        {
+            printf(" ERRO: Falha ao abrir o pacote\n");
+            return 0;
+        }
+        exibir_nova_imagem(estado);
+        return 1;
     }
 
-    if (carregar_bitmap(caminho, temp_buffer, IMG_WIDTH, IMG_HEIGHT) != 0)
+    /* Do cache ou decodificada do disco */
+    const unsigned char *imagem = ler_bmp(estado, caminho);
+
+    if (!imagem)
     {
         printf(" ERRO: Falha ao carregar bitmap\n");
-        printf("   Verifique se o arquivo existe e é um BMP válido (160x120, 8-bit)\n");
-        free(temp_buffer);
+        printf("   Verifique se o arquivo existe e é um BMP válido (8, 16, 24 ou 32 bits, RLE ou BI_BITFIELDS)\n");
         return 0;
     }
 
     /* Sucesso! Substituir imagem atual */
-    memcpy(estado->imagem_original, temp_buffer, IMG_SIZE);
-    memcpy(estado->imagem_atual, temp_buffer, IMG_SIZE);
-    free(temp_buffer);
-
-    /* Resetar estado */
-    estado->janela.pontos_definidos = 0;
-    estado->janela.ativo = 0;
-    estado->nivel_zoom = 1.0f;
-    estado->algoritmo = ALG_VIZINHO_PROXIMO;
+    estado->imagem_atual = imagem;
+    estado->quadro_pacote = -1;
 
     printf(" Nova imagem carregada com sucesso!\n");
-    printf(" Estado resetado (Zoom 1x, Algoritmo Vizinho Próximo)\n");
-
-    /* Atualizar display */
-    carregar_imagem(estado->imagem_atual, IMG_SIZE);
-    api_bypass();
+    exibir_nova_imagem(estado);
 
     return 1;
 }
@@ -652,6 +757,11 @@ void mostrar_interface(EstadoApp *estado)
 
     printf("\nPosição do Mouse: (%d, %d)\n", estado->mouse_x, estado->mouse_y);
     printf("Zoom Atual: %.2fx\n", estado->nivel_zoom);
+    if (estado->quadro_pacote >= 0)
+    {
+        printf("Imagem: quadro %d/%d do pacote (%s)\n", estado->quadro_pacote + 1,
+               estado->pacote.total, estado->pacote.entradas[estado->quadro_pacote].nome);
+    }
 
     printf("Algoritmo Selecionado: ");
     switch (estado->algoritmo)
@@ -667,6 +777,29 @@ void mostrar_interface(EstadoApp *estado)
         break;
     }
 
+    if (coprocessador_ocupado())
+    {
+        printf("ALU: processando...\n");
+    }
+    else
+    {
+        unsigned int ciclos = coprocessador_ciclos();
+        printf("ALU: última operação em %u ciclos (%.2f ms a 25 MHz)\n",
+               ciclos, ciclos / 25000.0);
+    }
+
+    if (estado->cache.capacidade > 0)
+    {
+        printf("Cache de imagens: %d/%d (%zu KB), %lu acerto(s), %lu falta(s)\n",
+               estado->cache.ocupadas, estado->cache.capacidade,
+               estado->cache.capacidade * (size_t)IMG_SIZE / 1024,
+               estado->cache.acertos, estado->cache.faltas);
+    }
+    else
+    {
+        printf("Cache de imagens: desligado (CACHE_IMAGENS_KB=0)\n");
+    }
+
     printf("\nJanela de Zoom:\n");
     if (estado->janela.pontos_definidos == 0)
     {
@@ -691,10 +824,12 @@ void mostrar_interface(EstadoApp *estado)
     printf("║ [Clique Esquerdo]  → Definir cantos da janela          ║\n");
     printf("║ [+]                → Zoom In                           ║\n");
     printf("║ [-]                → Zoom Out                          ║\n");
+    printf("║ [ e ]              → Zoom fino (0.75x, 1.5x, 3x)       ║\n");
     printf("║ [1]                → Algoritmo: Vizinho Próximo        ║\n");
     printf("║ [2]                → Algoritmo: Replicação (2x/4x)     ║\n");
     printf("║ [3]                → Algoritmo: Média (0.5x/0.25x)     ║\n");
-    printf("║ [L]                → Carregar nova imagem BMP          ║\n");
+    printf("║ [L]                → Carregar nova imagem BMP/pacote   ║\n");
+    printf("║ [N] / [P]          → Próximo/anterior quadro do pacote ║\n");
     printf("║ [R]                → Resetar janela                    ║\n");
     printf("║ [Q]                → Sair                              ║\n");
     printf("╚════════════════════════════════════════════════════════╝\n");
@@ -714,9 +849,50 @@ void mostrar_interface(EstadoApp *estado)
     }
 }
 
+/* Nível seguinte (direcao > 0) ou anterior de niveis_zoom_fino a partir de
+ * um zoom qualquer; nos limites retorna o próprio zoom */
+float proximo_nivel_fino(float zoom_atual, int direcao)
+{
+    int i;
+
+    if (direcao > 0)
+    {
+        for (i = 0; i < TOTAL_NIVEIS_FINOS; i++)
+            if (niveis_zoom_fino[i] > zoom_atual)
+                return niveis_zoom_fino[i];
+    }
+    else
+    {
+        for (i = TOTAL_NIVEIS_FINOS - 1; i >= 0; i--)
+            if (niveis_zoom_fino[i] < zoom_atual)
+                return niveis_zoom_fino[i];
+    }
+    return zoom_atual;
+}
+
+/* Dobro (direcao > 0) ou metade do zoom, levado para o nível de
+ * niveis_zoom_fino mais próximo nessa direção: 0.75x -> 0.25x, 3x -> 4x */
+float proximo_nivel_dobro(float zoom_atual, int direcao)
+{
+    float alvo = (direcao > 0) ? zoom_atual * 2.0f : zoom_atual / 2.0f;
+    int i;
+
+    if (direcao > 0)
+    {
+        for (i = 0; i < TOTAL_NIVEIS_FINOS; i++)
+            if (niveis_zoom_fino[i] >= alvo)
+                return niveis_zoom_fino[i];
+        return ZOOM_MAXIMO;
+    }
+    for (i = TOTAL_NIVEIS_FINOS - 1; i >= 0; i--)
+        if (niveis_zoom_fino[i] <= alvo)
+            return niveis_zoom_fino[i];
+    return ZOOM_MINIMO;
+}
+
 int validar_mudanca_zoom(TipoAlgoritmo algoritmo, float zoom_atual, int direcao)
 {
-    float novo_zoom = (direcao > 0) ? zoom_atual * 2.0f : zoom_atual / 2.0f;
+    float novo_zoom = proximo_nivel_dobro(zoom_atual, direcao);
 
     /* Algoritmo Média só funciona com redução (0.5x e 0.25x) */
     if (algoritmo == ALG_MEDIA && novo_zoom > 1.0f)
@@ -741,7 +917,7 @@ int main(int argc, char **argv)
 {
     if (argc != 2)
     {
-        fprintf(stderr, "Uso: %s <arquivo.bmp>\n", argv[0]);
+        fprintf(stderr, "Uso: %s <arquivo.bmp | pacote>\n", argv[0]);
         return 1;
     }
 
@@ -749,32 +925,51 @@ int main(int argc, char **argv)
     EstadoApp estado = {0};
     estado.nivel_zoom = 1.0f;
     estado.algoritmo = ALG_VIZINHO_PROXIMO;
+    estado.quadro_pacote = -1;
 
-    /* Alocar buffers */
-    estado.imagem_original = (unsigned char *)malloc(IMG_SIZE);
-    estado.imagem_atual = (unsigned char *)malloc(IMG_SIZE);
-
-    if (!estado.imagem_original || !estado.imagem_atual)
+    /* Alocar todos os buffers de quadro de uma vez */
+    if (criar_arena_quadros() != 0)
     {
         fprintf(stderr, "ERRO: Falha ao alocar memória\n");
         return 1;
     }
+    estado.imagem_original = quadro_arena(QUADRO_ORIGINAL);
+    estado.imagem_atual = estado.imagem_original;
+    if (criar_cache(&estado) != 0)
+    {
+        fprintf(stderr, "ERRO: Falha ao alocar o cache de imagens\n");
+        destruir_arena_quadros();
+        return 1;
+    }
 
     /* ====================================================================
-       CARREGAR BITMAP
+       CARREGAR BITMAP OU PACOTE
        ==================================================================== */
-    printf("Carregando arquivo bitmap: %s\n", argv[1]);
-
-    if (carregar_bitmap(argv[1], estado.imagem_original, IMG_WIDTH, IMG_HEIGHT) != 0)
+    if (e_pacote(argv[1]))
     {
-        fprintf(stderr, "ERRO: Falha ao carregar bitmap\n");
-        free(estado.imagem_original);
-        free(estado.imagem_atual);
-        return 1;
+        printf("Mapeando pacote: %s\n", argv[1]);
+        if (abrir_novo_pacote(&estado, argv[1]) != 0)
+        {
+            fprintf(stderr, "ERRO: Falha ao abrir o pacote\n");
+            destruir_cache_imagens(&estado.cache);
+            destruir_arena_quadros();
+            return 1;
+        }
     }
+    else
+    {
+        printf("Carregando arquivo bitmap: %s\n", argv[1]);
 
-    memcpy(estado.imagem_atual, estado.imagem_original, IMG_SIZE);
-    printf(" Bitmap carregado com sucesso!\n");
+        estado.imagem_atual = ler_bmp(&estado, argv[1]);
+        if (!estado.imagem_atual)
+        {
+            fprintf(stderr, "ERRO: Falha ao carregar bitmap\n");
+            destruir_cache_imagens(&estado.cache);
+            destruir_arena_quadros();
+            return 1;
+        }
+        printf(" Bitmap carregado com sucesso!\n");
+    }
 
     /* ====================================================================
        INICIALIZAR COPROCESSADOR
@@ -784,8 +979,12 @@ int main(int argc, char **argv)
     printf(" Coprocessador inicializado!\n");
 
     /* Carregar imagem inicial */
-    carregar_imagem(estado.imagem_atual, IMG_SIZE);
+    invalidar_bancos(&estado);
+    estado.fpga_sincronizada[coprocessador_banco_carga()] = 1;
+    carregar_imagem((unsigned char *)estado.imagem_atual, IMG_SIZE);
+    coprocessador_roi(0, 0, 0, 0); /* o PIO guarda a ROI da execução anterior */
     api_bypass();
+    atualizar_overlay(&estado);
 
     /* ====================================================================
        ABRIR DISPOSITIVO DE MOUSE
@@ -806,6 +1005,25 @@ int main(int argc, char **argv)
         }
     }
 
+    /* ====================================================================
+       LAÇO DE EVENTOS: mouse, teclado e timer da animação
+       ==================================================================== */
+    int epoll_fd = epoll_create1(0);
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+
+    if (epoll_fd < 0 || timer_fd < 0 ||
+        registrar_evento(epoll_fd, STDIN_FILENO) != 0 ||
+        registrar_evento(epoll_fd, timer_fd) != 0 ||
+        (mouse_fd >= 0 && registrar_evento(epoll_fd, mouse_fd) != 0))
+    {
+        fprintf(stderr, "ERRO: Falha ao criar o laço de eventos\n");
+        encerrar_coprocessador();
+        fechar_pacote(&estado.pacote);
+        destruir_cache_imagens(&estado.cache);
+        destruir_arena_quadros();
+        return 1;
+    }
+
     /* Configurar terminal */
     configurar_terminal_nao_canonico();
 
@@ -813,18 +1031,50 @@ int main(int argc, char **argv)
        LOOP PRINCIPAL
        ==================================================================== */
     struct input_event ev;
+    struct epoll_event eventos[3];
     int executando = 1;
     int mouse_moved = 0;
     int last_mouse_x = -1;
     int last_mouse_y = -1;
-    int update_counter = 0;
+    unsigned int ultimo_quadro = coprocessador_quadro() - 1;
+    long long instante_quadro = agora_us();
+    int animacao_ativa = 0;
 
     mostrar_interface(&estado);
 
     while (executando)
     {
+        int mouse_pronto = 0, tecla_pronta = 0, animar = 0, posicao_mudou = 0;
+        int i, n;
+
+        /* Dorme até chegar um evento; com movimento pendente acorda uma
+         * vez, quando o quadro já desenhado termina */
+        n = epoll_wait(epoll_fd, eventos, 3,
+                       mouse_moved ? espera_proximo_quadro_ms(instante_quadro) : -1);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            if (eventos[i].data.fd == mouse_fd)
+                mouse_pronto = 1;
+            else if (eventos[i].data.fd == STDIN_FILENO)
+                tecla_pronta = 1;
+            else if (eventos[i].data.fd == timer_fd)
+            {
+                uint64_t expiracoes;
+                if (read(timer_fd, &expiracoes, sizeof(expiracoes)) == sizeof(expiracoes))
+                    animar = 1;
+            }
+        }
+
         /* Processar eventos do mouse */
-        if (mouse_fd >= 0)
+        if (mouse_pronto)
         {
             while (read(mouse_fd, &ev, sizeof(ev)) > 0)
             {
@@ -848,10 +1098,7 @@ int main(int argc, char **argv)
                             estado.mouse_y = IMG_HEIGHT - 1;
                         mouse_moved = 1;
                     }
-
-                    /* Atualizar display no terminal */
-                    printf("\r Mouse: (%d, %d)    ", estado.mouse_x, estado.mouse_y);
-                    fflush(stdout);
+                    posicao_mudou = 1;
                 }
                 else if (ev.type == EV_KEY && ev.code == BTN_LEFT && ev.value == 1)
                 {
@@ -871,7 +1118,7 @@ int main(int argc, char **argv)
                         estado.janela.pontos_definidos = 1;
                         printf("\n Primeiro canto definido: (%d, %d)\n",
                                estado.janela.x1, estado.janela.y1);
-                        mouse_moved = 1;
+                        atualizar_overlay(&estado);
                     }
                     else if (estado.janela.pontos_definidos == 1)
                     {
@@ -884,53 +1131,71 @@ int main(int argc, char **argv)
                                estado.janela.x2, estado.janela.y2);
                         printf(" Janela ativada!\n");
                         mostrar_interface(&estado);
-                        mouse_moved = 1;
+                        atualizar_overlay(&estado);
                     }
                 }
             }
         }
 
-        /* ATUALIZAR VGA QUANDO MOUSE SE MOVER - APENAS EM BYPASS (1X) */
-        if (mouse_moved &&
-            (estado.mouse_x != last_mouse_x || estado.mouse_y != last_mouse_y))
+        /* Atualizar display no terminal uma vez por lote de eventos */
+        if (posicao_mudou)
         {
+            printf("\r Mouse: (%d, %d)    ", estado.mouse_x, estado.mouse_y);
+            fflush(stdout);
+        }
 
-            /* Só atualiza cursor em tempo real se estiver em modo bypass (1x) */
-            if (estado.nivel_zoom == 1.0f)
+        /* ATUALIZAR CURSOR QUANDO MOUSE SE MOVER (overlay, sem ALU) */
+        if (mouse_moved &&
+            estado.mouse_x == last_mouse_x && estado.mouse_y == last_mouse_y)
+        {
+            mouse_moved = 0; /* Voltou à posição já desenhada */
+        }
+        else if (mouse_moved)
+        {
+            /* No máximo uma atualização por quadro VGA: os eventos que
+             * chegam durante o quadro ficam pendentes e saem juntos, já
+             * com a posição mais recente */
+            unsigned int quadro = coprocessador_quadro();
+            if (quadro != ultimo_quadro)
             {
-                processar_com_algoritmo(&estado);
-            }
+                ultimo_quadro = quadro;
+                instante_quadro = agora_us();
+                atualizar_overlay(&estado);
 
-            last_mouse_x = estado.mouse_x;
-            last_mouse_y = estado.mouse_y;
-            mouse_moved = 0;
+                last_mouse_x = estado.mouse_x;
+                last_mouse_y = estado.mouse_y;
+                mouse_moved = 0;
+            }
         }
 
         /* Atualização periódica para animação do primeiro canto - APENAS EM 1X */
-        if (estado.janela.pontos_definidos == 1 && estado.nivel_zoom == 1.0f)
+        if (animar && estado.janela.pontos_definidos == 1 && estado.nivel_zoom == 1.0f)
         {
-            if (update_counter++ % 50 == 0)
-            { /* A cada ~500ms */
-                processar_com_algoritmo(&estado);
-            }
+            estado.fase_canto++;
+            atualizar_overlay(&estado);
         }
 
-        /* Processar teclas */
-        if (tecla_disponivel())
+        /* Processar teclas (stdin encerrado sai do epoll para não acordar à toa) */
+        char tecla;
+        int lidos = tecla_pronta ? read(STDIN_FILENO, &tecla, 1) : -1;
+        if (lidos == 0)
+        {
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, STDIN_FILENO, NULL);
+        }
+        else if (lidos == 1)
         {
-            char tecla = getchar();
 
             switch (tecla)
             {
             case '+':
             case '=':
                 /* Zoom in */
-                if (estado.nivel_zoom < 4.0f)
+                if (estado.nivel_zoom < ZOOM_MAXIMO)
                 {
                     /* Validar se o algoritmo suporta o próximo nível de zoom */
                     if (validar_mudanca_zoom(estado.algoritmo, estado.nivel_zoom, 1))
                     {
-                        estado.nivel_zoom *= 2.0f;
+                        estado.nivel_zoom = proximo_nivel_dobro(estado.nivel_zoom, 1);
                         processar_com_algoritmo(&estado);
                         mostrar_interface(&estado);
                     }
@@ -938,7 +1203,7 @@ int main(int argc, char **argv)
                     {
                         printf("\n  Algoritmo %s não suporta zoom %.2fx\n",
                                estado.algoritmo == ALG_MEDIA ? "Média" : "Replicação",
-                               estado.nivel_zoom * 2.0f);
+                               proximo_nivel_dobro(estado.nivel_zoom, 1));
                         printf("   Use [1] para Vizinho Próximo (suporta todos os zooms)\n");
                     }
                 }
@@ -951,12 +1216,12 @@ int main(int argc, char **argv)
             case '-':
             case '_':
                 /* Zoom out */
-                if (estado.nivel_zoom > 0.25f)
+                if (estado.nivel_zoom > ZOOM_MINIMO)
                 {
                     /* Validar se o algoritmo suporta o próximo nível de zoom */
                     if (validar_mudanca_zoom(estado.algoritmo, estado.nivel_zoom, -1))
                     {
-                        estado.nivel_zoom /= 2.0f;
+                        estado.nivel_zoom = proximo_nivel_dobro(estado.nivel_zoom, -1);
                         processar_com_algoritmo(&estado);
                         mostrar_interface(&estado);
                     }
@@ -964,7 +1229,7 @@ int main(int argc, char **argv)
                     {
                         printf("\n  Algoritmo %s não suporta zoom %.2fx\n",
                                estado.algoritmo == ALG_REPLICACAO ? "Replicação" : "Média",
-                               estado.nivel_zoom / 2.0f);
+                               proximo_nivel_dobro(estado.nivel_zoom, -1));
                         printf("   Use [1] para Vizinho Próximo (suporta todos os zooms)\n");
                     }
                 }
@@ -974,6 +1239,32 @@ int main(int argc, char **argv)
                 }
                 break;
 
+            case '[':
+            case ']':
+            {
+                /* Zoom fino: fatores fora das potências de 2 vão para a escala DDA */
+                float novo_zoom = proximo_nivel_fino(estado.nivel_zoom, tecla == ']' ? 1 : -1);
+
+                if (novo_zoom == estado.nivel_zoom)
+                {
+                    printf("\n  Zoom %s atingido (%.2fx)\n",
+                           tecla == ']' ? "máximo" : "mínimo", estado.nivel_zoom);
+                }
+                else if (!algoritmo_zoom_compativel(estado.algoritmo, novo_zoom))
+                {
+                    printf("\n  Algoritmo %s não suporta zoom %.2fx\n",
+                           estado.algoritmo == ALG_MEDIA ? "Média" : "Replicação", novo_zoom);
+                    printf("   Use [1] para Vizinho Próximo (suporta todos os zooms)\n");
+                }
+                else
+                {
+                    estado.nivel_zoom = novo_zoom;
+                    processar_com_algoritmo(&estado);
+                    mostrar_interface(&estado);
+                }
+                break;
+            }
+
             case '1':
                 estado.algoritmo = ALG_VIZINHO_PROXIMO;
                 printf("\n Algoritmo alterado: Vizinho Próximo\n");
@@ -1028,6 +1319,28 @@ int main(int argc, char **argv)
                 }
                 break;
 
+            case 'n':
+            case 'N':
+            case 'p':
+            case 'P':
+                /* Quadro vizinho do pacote, em círculo */
+                if (!estado.pacote.base)
+                {
+                    printf("\n  Nenhum pacote aberto (use [L] ou inicie com um pacote)\n");
+                    break;
+                }
+                {
+                    int passo = (tecla == 'n' || tecla == 'N') ? 1 : -1;
+                    /* Vindo de um BMP: [N] vai ao primeiro quadro, [P] ao último */
+                    int atual = (estado.quadro_pacote >= 0) ? estado.quadro_pacote
+                                                            : (passo > 0 ? -1 : 0);
+                    selecionar_quadro_pacote(&estado, (atual + passo + estado.pacote.total) %
+                                                          estado.pacote.total);
+                }
+                exibir_nova_imagem(&estado);
+                mostrar_interface(&estado);
+                break;
+
             case 'r':
             case 'R':
                 /* Resetar janela */
@@ -1046,7 +1359,13 @@ int main(int argc, char **argv)
             }
         }
 
-        usleep(10000); /* 10ms delay */
+        /* Timer só corre enquanto há um primeiro canto para animar */
+        int animacao = (estado.janela.pontos_definidos == 1 && estado.nivel_zoom == 1.0f);
+        if (animacao != animacao_ativa)
+        {
+            programar_timer(timer_fd, animacao ? PERIODO_ANIMACAO_MS : 0);
+            animacao_ativa = animacao;
+        }
     }
 
     /* ====================================================================
@@ -1056,16 +1375,21 @@ int main(int argc, char **argv)
 
     restaurar_terminal();
 
+    close(timer_fd);
+    close(epoll_fd);
     if (mouse_fd >= 0)
     {
         close(mouse_fd);
     }
 
+    overlay_cursor(0, 0, 0);
+    overlay_janela(OVERLAY_OCULTO, 0, 0, 0, 0);
     limpar_imagem();
     encerrar_coprocessador();
 
-    free(estado.imagem_original);
-    free(estado.imagem_atual);
+    fechar_pacote(&estado.pacote);
+    destruir_cache_imagens(&estado.cache);
+    destruir_arena_quadros();
 
     printf(" Sistema encerrado com sucesso!\n");
     printf("╔════════════════════════════════════════════════════════╗\n");
@@ -0,0 +1,76 @@
+// ========================================================================
+// mapa_ponte.h
+// Mapa de memória da ponte Lightweight HPS-FPGA
+//
+// Espelha as constantes da seção de dados de coprocessador.s para os
+// backends escritos em C (ponte simulada e modelo da ALU)
+// ========================================================================
+
+#ifndef MAPA_PONTE_H
+#define MAPA_PONTE_H
+
+// Endereço físico e tamanho da janela Lightweight
+#define LW_BRIDGE_BASE      0xFF200000
+#define LW_BRIDGE_SPAN      0x30000         // 192KB
+
+// Offsets dos componentes na ponte Lightweight
+#define IMAGE_MEM_OFFSET    0x0000          // onchip_memory2_1 (2 bancos de imagem fonte)
+#define RESET_PIO_OFFSET    0x18000         // PIO de reset (pulso de start)
+#define CONFIG_PIO_OFFSET   0x18010         // PIO de 10 bits (opcode)
+#define STATUS_PIO_OFFSET   0x18020         // PIO de status (entrada, 32 bits)
+#define VGA_PIO_OFFSET      0x18030         // PIO do VGA (entrada, 32 bits)
+#define CURSOR_PIO_OFFSET   0x18040         // Overlay: cursor
+#define JANELA_INI_PIO_OFFSET 0x18050       // Overlay: modo e canto (x1, y1)
+#define JANELA_FIM_PIO_OFFSET 0x18060       // Overlay: canto (x2, y2)
+#define LIMPEZA_PIO_OFFSET  0x18070         // Ciclos da fase de limpeza (entrada)
+#define PASSO_X_PIO_OFFSET  0x18080         // Escala DDA: passo horizontal 16.16
+#define PASSO_Y_PIO_OFFSET  0x18090         // Escala DDA: passo vertical 16.16
+#define ROI_PIO_OFFSET      0x180A0         // Região de interesse da imagem fonte
+#define CONTADOR_SEL_PIO_OFFSET 0x180B0     // Índice do contador de desempenho
+#define CONTADOR_PIO_OFFSET 0x180C0         // Valor do contador selecionado (entrada)
+
+// Bit do PIO de configuração que escolhe o banco lido pela ALU
+#define CONFIG_BANCO        (1 << 7)
+
+// Campos do PIO de status: {ciclos[29:0], ocupado, concluido}
+#define STATUS_CONCLUIDO    (1u << 0)
+#define STATUS_OCUPADO      (1u << 1)
+#define STATUS_CICLOS_SHIFT 2
+
+// Campos do PIO do VGA: {quadros[30:0], vblank}
+#define VGA_VBLANK          (1u << 0)
+#define VGA_QUADRO_SHIFT    1
+
+// Campos dos PIOs do overlay: {..., y[19:10], x[9:0]}
+#define OVERLAY_COORD_MASK  0x3FF
+#define OVERLAY_Y_SHIFT     10
+#define OVERLAY_VISIVEL     (1u << 20)      // pio_cursor
+#define OVERLAY_MODO_SHIFT  20              // pio_janela_ini
+
+// Campos do PIO da ROI: {ativa[31], alt[30:24], larg[23:16], y0[14:8], x0[7:0]}
+#define ROI_ATIVA           (1u << 31)
+#define ROI_ALT_SHIFT       24
+#define ROI_LARG_SHIFT      16
+#define ROI_Y_SHIFT         8
+
+// Índices do banco de contadores (contadores_alu.v)
+#define CONTADOR_CICLOS     0
+#define CONTADOR_LIMPEZA    1
+#define CONTADOR_LEITURAS_ROM 2
+#define CONTADOR_ESCRITAS_FB  3
+#define CONTADOR_LATENCIA   4
+#define CONTADOR_CONCLUIDAS 5
+#define CONTADOR_ABORTADAS  6
+#define TOTAL_CONTADORES    7
+
+// Dimensões da imagem fonte
+#define IMAGE_WIDTH         160
+#define IMAGE_HEIGHT        120
+#define IMAGE_SIZE          (IMAGE_WIDTH * IMAGE_HEIGHT)
+
+// Dimensões do framebuffer VGA (blocoram)
+#define FB_WIDTH            640
+#define FB_HEIGHT           480
+#define FB_SIZE             (FB_WIDTH * FB_HEIGHT)
+
+#endif // MAPA_PONTE_H
@@ -0,0 +1,124 @@
+// ========================================================================
+// pacote.c - Leitura do pacote de quadros pré-processados (ver pacote.h)
+// ========================================================================
+
+#include "pacote.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+_Static_assert(sizeof(PacoteHeader) == 64 && sizeof(PacoteEntrada) == 64,
+               "header e entradas do pacote ocupam 64 bytes");
+
+int e_pacote(const char *caminho)
+{
+    char assinatura[8];
+    int fd = open(caminho, O_RDONLY);
+    int resultado;
+
+    if (fd < 0)
+        return 0;
+    resultado = read(fd, assinatura, sizeof(assinatura)) == sizeof(assinatura) &&
+                memcmp(assinatura, PACOTE_ASSINATURA, sizeof(assinatura)) == 0;
+    close(fd);
+    return resultado;
+}
+
+/* Header e índice coerentes com o tamanho do arquivo; quadros alinhados */
+static int validar_pacote(const unsigned char *base, size_t tamanho)
+{
+    PacoteHeader header;
+    uint32_t i;
+
+    if (tamanho < sizeof(PacoteHeader))
+        return -1;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.assinatura, PACOTE_ASSINATURA, sizeof(header.assinatura)) != 0 ||
+        header.versao != PACOTE_VERSAO || header.largura != PACOTE_LARGURA ||
+        header.altura != PACOTE_ALTURA || header.bytes_quadro != PACOTE_BYTES_QUADRO ||
+        header.alinhamento != PACOTE_ALINHAMENTO)
+        return -1;
+    if (header.offset_indice % sizeof(PacoteEntrada) != 0 || header.offset_indice > tamanho ||
+        (tamanho - header.offset_indice) / sizeof(PacoteEntrada) < header.total)
+        return -1;
+
+    const PacoteEntrada *entradas = (const PacoteEntrada *)(base + header.offset_indice);
+    for (i = 0; i < header.total; i++)
+    {
+        if (entradas[i].offset % PACOTE_ALINHAMENTO != 0 || entradas[i].offset > tamanho ||
+            tamanho - entradas[i].offset < PACOTE_BYTES_QUADRO ||
+            memchr(entradas[i].nome, '\0', PACOTE_NOME_MAXIMO) == NULL)
+            return -1;
+    }
+    return 0;
+}
+
+int abrir_pacote(Pacote *pacote, const char *caminho)
+{
+    struct stat st;
+    int fd = open(caminho, O_RDONLY);
+
+    memset(pacote, 0, sizeof(*pacote));
+    if (fd < 0)
+    {
+        fprintf(stderr, "ERRO: Não foi possível abrir '%s'\n", caminho);
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(PacoteHeader))
+    {
+        fprintf(stderr, "ERRO: Pacote '%s' truncado\n", caminho);
+        close(fd);
+        return -1;
+    }
+
+    // Sem MAP_POPULATE: um pacote pode ter milhares de quadros, e cada um
+    // só é lido do disco quando for enviado à FPGA
+    size_t tamanho = (size_t)st.st_size;
+    const unsigned char *base = (const unsigned char *)mmap(
+        NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        fprintf(stderr, "ERRO: Falha ao mapear '%s'\n", caminho);
+        return -1;
+    }
+    if (validar_pacote(base, tamanho) != 0)
+    {
+        fprintf(stderr, "ERRO: Pacote '%s' inválido\n", caminho);
+        munmap((void *)base, tamanho);
+        return -1;
+    }
+
+    const PacoteHeader *header = (const PacoteHeader *)base;
+    pacote->base = base;
+    pacote->tamanho = tamanho;
+    pacote->entradas = (const PacoteEntrada *)(base + header->offset_indice);
+    pacote->total = (int)header->total;
+    return 0;
+}
+
+void fechar_pacote(Pacote *pacote)
+{
+    if (pacote->base)
+        munmap((void *)pacote->base, pacote->tamanho);
+    memset(pacote, 0, sizeof(*pacote));
+}
+
+const unsigned char *pacote_quadro(const Pacote *pacote, int indice)
+{
+    return pacote->base + pacote->entradas[indice].offset;
+}
+
+int procurar_no_pacote(const Pacote *pacote, const char *nome)
+{
+    int i;
+    for (i = 0; i < pacote->total; i++)
+    {
+        if (strcmp(pacote->entradas[i].nome, nome) == 0)
+            return i;
+    }
+    return -1;
+}
@@ -0,0 +1,90 @@
+// ========================================================================
+// pacote.h - Formato do pacote de quadros pré-processados
+//
+// Um arquivo com vários quadros 160x120 em tons de cinza já convertidos,
+// prontos para carregar_imagem(): um header, uma tabela de índice com o
+// nome de cada quadro e os quadros contíguos de 19200 bytes, cada um
+// alinhado em 64 bytes. Gerado por auxiliares/converte -p. Inteiros em
+// little-endian (o mesmo do HPS e do PC). main.c mapeia o pacote com
+// abrir_pacote() e envia os quadros direto do mapeamento.
+//
+//   0                       PacoteHeader (64 bytes)
+//   offset_indice           PacoteEntrada[total] (64 bytes cada)
+//   offset_quadros          quadros, na ordem das entradas
+// ========================================================================
+
+#ifndef PACOTE_H
+#define PACOTE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PACOTE_ASSINATURA   "QUADROS"       // 8 bytes com o '\0'
+#define PACOTE_VERSAO       1
+#define PACOTE_LARGURA      160
+#define PACOTE_ALTURA       120
+#define PACOTE_BYTES_QUADRO (PACOTE_LARGURA * PACOTE_ALTURA)
+#define PACOTE_ALINHAMENTO  64
+#define PACOTE_NOME_MAXIMO  56
+
+#pragma pack(push, 1)
+
+typedef struct {
+    char     assinatura[8];     // PACOTE_ASSINATURA
+    uint32_t versao;            // PACOTE_VERSAO
+    uint32_t total;             // Número de entradas
+    uint32_t largura;           // 160
+    uint32_t altura;            // 120
+    uint32_t bytes_quadro;      // 19200
+    uint32_t alinhamento;       // 64
+    uint64_t offset_indice;     // Início da tabela de entradas
+    uint64_t offset_quadros;    // Início do primeiro quadro (alinhado)
+    uint8_t  reservado[16];
+} PacoteHeader;
+
+typedef struct {
+    char     nome[PACOTE_NOME_MAXIMO];  // Nome de origem, sem diretório ('\0' no fim)
+    uint64_t offset;                    // Início do quadro no arquivo (alinhado)
+} PacoteEntrada;
+
+#pragma pack(pop)
+
+/* Pacote aberto: o arquivo inteiro mapeado, só leitura */
+typedef struct {
+    const unsigned char *base;      // NULL = nenhum pacote aberto
+    size_t tamanho;
+    const PacoteEntrada *entradas;
+    int total;
+} Pacote;
+
+/**
+ * 1 se o arquivo começa com a assinatura de um pacote, 0 caso contrário
+ */
+int e_pacote(const char *caminho);
+
+/**
+ * Mapeia um pacote e valida header, índice e quadros uma única vez:
+ * depois disso pacote_quadro() é só uma conta de ponteiro
+ * 
+ * @param pacote: Estrutura a preencher
+ * @param caminho: Arquivo gerado por auxiliares/converte -p
+ * @return 0 em sucesso, -1 em erro
+ */
+int abrir_pacote(Pacote *pacote, const char *caminho);
+
+/**
+ * Desfaz o mapeamento (os ponteiros de pacote_quadro() deixam de valer)
+ */
+void fechar_pacote(Pacote *pacote);
+
+/**
+ * Quadro 160x120 de uma entrada, alinhado em 64 bytes dentro do mapeamento
+ */
+const unsigned char *pacote_quadro(const Pacote *pacote, int indice);
+
+/**
+ * Índice da entrada com esse nome, ou -1
+ */
+int procurar_no_pacote(const Pacote *pacote, const char *nome);
+
+#endif // PACOTE_H